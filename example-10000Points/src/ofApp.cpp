@@ -8,6 +8,7 @@ void ofApp::setup() {
 	// Initialize the global variables
 	pointColor = ofColor(255, 0, 0, 155);
 	drawLines = true;
+	drawDensity = false;
 	circleResolution = 22;
 
 	// Set the circle resolution
@@ -58,7 +59,12 @@ void ofApp::draw() {
 		plot.drawLines();
 	}
 
-	plot.drawPoints(pointColor); // this is 3 times faster than drawPoints()
+	if (drawDensity) {
+		plot.drawDensities(); // the cost depends on the plot size and not on the number of points
+	} else {
+		plot.drawPoints(pointColor);
+	}
+
 	plot.drawLabels();
 	plot.endDraw();
 }
@@ -67,6 +73,8 @@ void ofApp::draw() {
 void ofApp::keyPressed(int key) {
 	if (key == 'l') {
 		drawLines = !drawLines;
+	} else if (key == 'd') {
+		drawDensity = !drawDensity;
 	} else if (key == '+') {
 		circleResolution = ofClamp(++circleResolution, 3, 50);
 		ofSetCircleResolution(circleResolution);
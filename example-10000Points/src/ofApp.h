@@ -21,6 +21,7 @@ public:
 
 	ofColor pointColor;
 	bool drawLines;
+	bool drawDensity;
 	int circleResolution;
 	ofxGPlot plot;
 };
@@ -12,8 +12,13 @@ void ofApp::setup() {
 	// Set the rectangle position and size
 	rect.set(imgPos, 20, 20);
 
-	// Calculate the color histograms
-	calculateHistograms();
+	// Set the histogram bins. Each bin covers two color values
+	redBinner.setBins(128, { 0, 256 });
+	redBinner.setNormalized(true);
+	greenBinner.setBins(128, { 0, 256 });
+	greenBinner.setNormalized(true);
+	blueBinner.setBins(128, { 0, 256 });
+	blueBinner.setNormalized(true);
 
 	// Setup for the first plot
 	plot1.setPos(0, 0);
@@ -22,7 +27,6 @@ void ofApp::setup() {
 	plot1.setTitleText("Color histograms");
 	plot1.getYAxis().getAxisLabel().setText("N");
 	plot1.getYAxis().getAxisLabel().setRotate(false);
-	plot1.setPoints(redHistPoints);
 	plot1.startHistograms(GRAFICA_VERTICAL_HISTOGRAM);
 	plot1.getHistogram().setBgColors( { ofColor(255, 0, 0, 100) });
 	plot1.getHistogram().setLineColors( { ofColor(0, 0) });
@@ -36,7 +40,6 @@ void ofApp::setup() {
 	plot2.setXLim(0, 255);
 	plot2.getYAxis().getAxisLabel().setText("N");
 	plot2.getYAxis().getAxisLabel().setRotate(false);
-	plot2.setPoints(greenHistPoints);
 	plot2.startHistograms(GRAFICA_VERTICAL_HISTOGRAM);
 	plot2.getHistogram().setBgColors( { ofColor(0, 255, 0, 100) });
 	plot2.getHistogram().setLineColors( { ofColor(0, 0) });
@@ -51,49 +54,52 @@ void ofApp::setup() {
 	plot3.getXAxis().getAxisLabel().setText("color value");
 	plot3.getYAxis().getAxisLabel().setText("N");
 	plot3.getYAxis().getAxisLabel().setRotate(false);
-	plot3.setPoints(blueHistPoints);
 	plot3.startHistograms(GRAFICA_VERTICAL_HISTOGRAM);
 	plot3.getHistogram().setBgColors( { ofColor(0, 0, 255, 100) });
 	plot3.getHistogram().setLineColors( { ofColor(0, 0) });
 	plot3.getHistogram().setSeparations( { 0 });
 	plot3.activateZooming(1.2, OF_MOUSE_BUTTON_LEFT, OF_MOUSE_BUTTON_LEFT);
 	plot3.activateReset();
+
+	// Calculate the color histograms and update the plots
+	calculateHistograms();
 }
 
 //--------------------------------------------------------------
 void ofApp::calculateHistograms() {
-	// Calculate the color histograms
-	int delta = 2;
-	int nBins = 255 / delta;
-	vector<float> redHist(nBins, 0);
-	vector<float> greenHist(nBins, 0);
-	vector<float> blueHist(nBins, 0);
+	// Get the color values inside the rectangle
 	int xStart = ofClamp(rect.getX() - imgPos.x, 0, img.getWidth());
 	int yStart = ofClamp(rect.getY() - imgPos.y, 0, img.getHeight());
 	int xEnd = ofClamp(rect.getX() + rect.getWidth() - imgPos.x, 0, img.getWidth());
 	int yEnd = ofClamp(rect.getY() + rect.getHeight() - imgPos.y, 0, img.getHeight());
-	int counter = 0;
+	redValues.clear();
+	greenValues.clear();
+	blueValues.clear();
 
 	for (int x = xStart; x < xEnd; ++x) {
 		for (int y = yStart; y < yEnd; ++y) {
 			ofColor c = img.getColor(x, y);
-			++redHist[c.r / delta];
-			++greenHist[c.g / delta];
-			++blueHist[c.b / delta];
-			++counter;
+			redValues.push_back(c.r);
+			greenValues.push_back(c.g);
+			blueValues.push_back(c.b);
 		}
 	}
 
-	// Calculate the plot points
-	redHistPoints.clear();
-	greenHistPoints.clear();
-	blueHistPoints.clear();
-
-	for (int i = 0; i < nBins; ++i) {
-		redHistPoints.emplace_back((i + 0.5) * delta, redHist[i] / counter);
-		greenHistPoints.emplace_back((i + 0.5) * delta, greenHist[i] / counter);
-		blueHistPoints.emplace_back((i + 0.5) * delta, blueHist[i] / counter);
-	}
+	// Calculate the color histograms
+	redBinner.clear();
+	redBinner.addSamples(redValues);
+	greenBinner.clear();
+	greenBinner.addSamples(greenValues);
+	blueBinner.clear();
+	blueBinner.addSamples(blueValues);
+
+	// Update the plots. Only the bars that changed are modified
+	redBinner.updateLayer(plot1.getMainLayer());
+	greenBinner.updateLayer(plot2.getMainLayer());
+	blueBinner.updateLayer(plot3.getMainLayer());
+	plot1.updateLimits();
+	plot2.updateLimits();
+	plot3.updateLimits();
 }
 
 //--------------------------------------------------------------
@@ -163,13 +169,8 @@ void ofApp::mouseDragged(int x, int y, int button) {
 	rect.setX(x - rect.getWidth() / 2);
 	rect.setY(y - rect.getHeight() / 2);
 
-	// Calculate the color histograms
+	// Calculate the color histograms and update the plots
 	calculateHistograms();
-
-	// Update the plots
-	plot1.setPoints(redHistPoints);
-	plot2.setPoints(greenHistPoints);
-	plot3.setPoints(blueHistPoints);
 }
 
 //--------------------------------------------------------------
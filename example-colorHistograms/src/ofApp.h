@@ -20,7 +20,8 @@ public:
 	void gotMessage(ofMessage msg);
 
 	ofxGPlot plot1, plot2, plot3;
-	vector<ofxGPoint> redHistPoints, greenHistPoints, blueHistPoints;
+	ofxGHistogramBinner redBinner, greenBinner, blueBinner;
+	vector<float> redValues, greenValues, blueValues;
 	ofImage img;
 	ofPoint imgPos;
 	ofRectangle rect;
@@ -10,30 +10,18 @@ void ofApp::setup() {
 	// country,income,health,population
 	// Central African Republic,599,53.8,4900274
 	// ...
-	ofBuffer buffer = ofBufferFromFile("data.csv");
+	ofxGTable table;
+	table.load("data.csv");
 
 	// Save the data in one ofxGPoint vector and calculate the point sizes
-	vector<ofxGPoint> points;
+	vector<ofxGPoint> points = table.getPoints(table.getColumnIndex("income"), table.getColumnIndex("health"),
+			table.getColumnIndex("country"));
 	vector<float> pointSizes;
-	bool firstLine = true;
-
-	for (auto line : buffer.getLines()) {
-		// Skip the header
-		if (firstLine) {
-			firstLine = false;
-		} else if (line.size() > 0) {
-			vector<string> columns = ofSplitString(line, ",");
-
-			string country = columns[0];
-			float income = stof(columns[1]);
-			float health = stof(columns[2]);
-			int population = stoi(columns[3]);
-			points.emplace_back(income, health, country);
-
-			// The point area should be proportional to the country population
-			// population = pi * sq(diameter/2)
-			pointSizes.emplace_back(sqrt(population / (200000 * PI)));
-		}
+
+	for (float population : table.getColumn(table.getColumnIndex("population"))) {
+		// The point area should be proportional to the country population
+		// population = pi * sq(diameter/2)
+		pointSizes.emplace_back(sqrt(population / (200000 * PI)));
 	}
 
 	// Create the plot
@@ -46,6 +46,9 @@ void ofApp::setup() {
 	plot.setPoints(points1);
 	plot.addLayer("surface", points2);
 
+	// Limit the number of points in the main layer. Adding a point will remove the oldest one
+	plot.setPointsCapacity(points1.size());
+
 	// Change the second layer line color
 	plot.getLayer("surface").setLineColor(ofColor(100, 255, 100));
 }
@@ -59,22 +62,16 @@ ofxGPoint ofApp::calculatePoint(float i, float n, float rad) {
 
 //--------------------------------------------------------------
 void ofApp::update() {
-	// Add and remove new points every 10th of a second
+	// Add new points every 10th of a second. The main layer is full, so the point at the other end is removed
 	if (ofGetElapsedTimeMillis() > 100) {
 		if (clockwise) {
 			// Add the point at the end of the array
 			plot.addPoint(calculatePoint(step, stepsPerCycle, scale));
 			++step;
-
-			// Remove the first point
-			plot.removePoint(0);
 		} else {
 			// Add the point at the beginning of the array
 			plot.addPoint(0, calculatePoint(step, stepsPerCycle, scale));
 			--step;
-
-			// Remove the last point
-			plot.removePoint(plot.getPointsRef().size() - 1);
 		}
 
 		// Reset the time
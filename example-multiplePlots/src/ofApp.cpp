@@ -63,24 +63,19 @@ void ofApp::setup() {
 	plot2.getYAxis().getAxisLabel().setText("-mouseY");
 
 	// Prepare the points for the third plot
-	gaussianCounter = 0;
 	generator = default_random_engine();
 	distribution = normal_distribution<float>(0.0, 1.0);
-	int gaussianStackSize = gaussianStack.size();
+	gaussianBinner.setBins(10, { -5, 5 });
+	gaussianBinner.setNormalized(true);
 
 	for (int i = 0; i < 20; ++i) {
-		int index = gaussianStackSize / 2.0 + distribution(generator);
-
-		if (index >= 0 && index < gaussianStackSize) {
-			++gaussianStack[index];
-			++gaussianCounter;
-		}
+		gaussianBinner.addSample(distribution(generator));
 	}
 
-	vector<ofxGPoint> points3;
+	vector<ofxGPoint> points3 = gaussianBinner.getPoints();
 
-	for (int i = 0; i < gaussianStackSize; ++i) {
-		points3.emplace_back(i + 0.5 - gaussianStackSize / 2.0, gaussianStack[i] / gaussianCounter, "H" + to_string(i));
+	for (vector<ofxGPoint>::size_type i = 0; i < points3.size(); ++i) {
+		points3[i].setLabel("H" + to_string(i));
 	}
 
 	// Setup for the third plot
@@ -88,7 +83,7 @@ void ofApp::setup() {
 	plot3.setDim(250, 250);
 	plot3.setYLim(-0.02, 0.45);
 	plot3.setXLim(-5, 5);
-	plot3.getTitle().setText("Gaussian distribution (" + to_string(gaussianCounter) + " points)");
+	plot3.getTitle().setText("Gaussian distribution (" + to_string(gaussianBinner.getTotalCount()) + " points)");
 	plot3.getTitle().setTextAlignment(GRAFICA_LEFT_ALIGN);
 	plot3.getTitle().setRelativePos(0);
 	plot3.getYAxis().getAxisLabel().setText("Relative probability");
@@ -102,29 +97,23 @@ void ofApp::setup() {
 			ofColor(0, 0, 255, 200) });
 
 	// Prepare the points for the fourth plot
-	uniformCounter = 0;
-	int uniformStackSize = uniformStack.size();
+	uniformBinner.setBins(30, { -15, 15 });
+	uniformBinner.setNormalized(true);
 
 	for (int i = 0; i < 20; ++i) {
-		int index = ofRandom(uniformStackSize);
-
-		if (index >= 0 && index < uniformStackSize) {
-			++uniformStack[index];
-			++uniformCounter;
-		}
+		uniformBinner.addSample(ofRandom(-15, 15));
 	}
 
-	vector<ofxGPoint> points4;
+	vector<ofxGPoint> points4 = uniformBinner.getPoints();
 
-	for (int i = 0; i < uniformStackSize; ++i) {
-		points4.emplace_back(i + 0.5 - uniformStackSize / 2.0, uniformStack[i] / uniformCounter,
-				"point " + to_string(i));
+	for (vector<ofxGPoint>::size_type i = 0; i < points4.size(); ++i) {
+		points4[i].setLabel("point " + to_string(i));
 	}
 
 	// Setup for the fourth plot
 	plot4.setPos(370, 350);
 	plot4.setYLim(-0.005, 0.1);
-	plot4.getTitle().setText("Uniform distribution (" + to_string(uniformCounter) + " points)");
+	plot4.getTitle().setText("Uniform distribution (" + to_string(uniformBinner.getTotalCount()) + " points)");
 	plot4.getTitle().setTextAlignment(GRAFICA_LEFT_ALIGN);
 	plot4.getTitle().setRelativePos(0.1);
 	plot4.getXAxis().getAxisLabel().setText("x variable");
@@ -157,42 +146,22 @@ void ofApp::update() {
 		}
 	}
 
-	// Add one more point to the gaussian stack
-	int gaussianStackSize = gaussianStack.size();
-	int index = gaussianStackSize / 2.0 + distribution(generator);
-
-	if (index >= 0 && index < gaussianStackSize) {
-		gaussianStack[index]++;
-		gaussianCounter++;
-
-		vector<ofxGPoint> points3;
+	// Add one more sample to the gaussian histogram. Only the bars that changed are updated
+	uint64_t gaussianCounter = gaussianBinner.getTotalCount();
+	gaussianBinner.addSample(distribution(generator));
 
-		for (int i = 0; i < gaussianStackSize; ++i) {
-			points3.emplace_back(i + 0.5 - gaussianStackSize / 2.0, gaussianStack[i] / gaussianCounter,
-					"H" + to_string(i));
-		}
-
-		plot3.setPoints(points3);
-		plot3.getTitle().setText("Gaussian distribution (" + to_string(gaussianCounter) + " points)");
+	if (gaussianBinner.getTotalCount() != gaussianCounter) {
+		gaussianBinner.updateLayer(plot3.getMainLayer());
+		plot3.getTitle().setText("Gaussian distribution (" + to_string(gaussianBinner.getTotalCount()) + " points)");
 	}
 
-	// Add one more point to the uniform stack
-	int uniformStackSize = uniformStack.size();
-	index = ofRandom(uniformStackSize);
-
-	if (index >= 0 && index < uniformStackSize) {
-		uniformStack[index]++;
-		uniformCounter++;
-
-		vector<ofxGPoint> points4;
-
-		for (int i = 0; i < uniformStackSize; ++i) {
-			points4.emplace_back(i + 0.5 - uniformStackSize / 2.0, uniformStack[i] / uniformCounter,
-					"point " + to_string(i));
-		}
+	// Add one more sample to the uniform histogram
+	uint64_t uniformCounter = uniformBinner.getTotalCount();
+	uniformBinner.addSample(ofRandom(-15, 15));
 
-		plot4.setPoints(points4);
-		plot4.getTitle().setText("Uniform distribution (" + to_string(uniformCounter) + " points)");
+	if (uniformBinner.getTotalCount() != uniformCounter) {
+		uniformBinner.updateLayer(plot4.getMainLayer());
+		plot4.getTitle().setText("Uniform distribution (" + to_string(uniformBinner.getTotalCount()) + " points)");
 	}
 
 	// Actions over the fourth plot (scrolling)
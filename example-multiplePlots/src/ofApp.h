@@ -26,10 +26,8 @@ public:
 	ofImage mug;
 	bool trackingMouse;
 	ofPath star;
-	int gaussianCounter;
-	array<float, 10> gaussianStack;
+	ofxGHistogramBinner gaussianBinner;
 	default_random_engine generator;
 	normal_distribution<float> distribution;
-	int uniformCounter;
-	array<float, 30> uniformStack;
+	ofxGHistogramBinner uniformBinner;
 };
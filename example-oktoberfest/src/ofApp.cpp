@@ -16,30 +16,24 @@ void ofApp::setup() {
 	// year,month,day,oktoberfest,bundestagswahl
 	// 2004,0,1,5,1
 	// ...
-	ofBuffer buffer = ofBufferFromFile("OktoberfestVSGermanElections.csv");
+	ofxGTable table;
+	table.load("OktoberfestVSGermanElections.csv");
+	const vector<float>& years = table.getColumn(0);
+	const vector<float>& months = table.getColumn(1);
+	const vector<float>& days = table.getColumn(2);
+	const vector<float>& oktoberfestCounts = table.getColumn(3);
+	const vector<float>& electionsCounts = table.getColumn(4);
 
 	// Save the data in two ofxGPoint vectors
 	vector<ofxGPoint> pointsOktoberfest;
 	vector<ofxGPoint> pointsElections;
-	bool firstLine = true;
-
-	for (auto line : buffer.getLines()) {
-		// Skip the header
-		if (firstLine) {
-			firstLine = false;
-		} else if (line.size() > 0) {
-			vector<string> columns = ofSplitString(line, ",");
-
-			int year = stoi(columns[0]);
-			int month = stoi(columns[1]);
-			int day = stoi(columns[2]);
-			int oktoberfestCount = stoi(columns[3]);
-			int electionsCount = stoi(columns[4]);
-			float date = getExactDate(year, month, day);
-
-			pointsOktoberfest.emplace_back(date, oktoberfestCount, monthNames[month]);
-			pointsElections.emplace_back(date, electionsCount, monthNames[month]);
-		}
+
+	for (size_t i = 0; i < table.getNumRows(); ++i) {
+		int month = months[i];
+		float date = getExactDate(years[i], month, days[i]);
+
+		pointsOktoberfest.emplace_back(date, oktoberfestCounts[i], monthNames[month]);
+		pointsElections.emplace_back(date, electionsCounts[i], monthNames[month]);
 	}
 
 	// Create the plot
@@ -1,8 +1,19 @@
 #include "ofxGAxis.h"
 #include "ofxGConstants.h"
 #include "ofxGAxisLabel.h"
+#include "ofxGFontRegistry.h"
 #include "ofMain.h"
 
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define OFXG_USE_TO_CHARS
+#endif
+
 ofxGAxis::ofxGAxis(ofxGAxisType _type, const array<float, 2>& _dim, const array<float, 2>& _lim, bool _logScale) :
 		type(_type), dim(_dim), lim(_lim), logScale(_logScale) {
 	// Do some sanity checks
@@ -35,7 +46,7 @@ ofxGAxis::ofxGAxis(ofxGAxisType _type, const array<float, 2>& _dim, const array<
 	fontColor = ofColor(0);
 	fontSize = 8;
 	fontMakeContours = false;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 
 	// Update the tick containers
 	updateTicks();
@@ -155,6 +166,9 @@ void ofxGAxis::updatePlotTicks() {
 			plotTicks.push_back((tick - lim[0]) * scaleFactor);
 		}
 	}
+
+	tickLabelsMeshNeedsUpdate = true;
+	ticksMeshNeedsUpdate = true;
 }
 
 void ofxGAxis::updateTicksInside() {
@@ -169,42 +183,157 @@ void ofxGAxis::updateTicksInside() {
 			ticksInside.push_back((-plotTick >= 0) && (-plotTick <= dim[1]));
 		}
 	}
+
+	tickLabelsMeshNeedsUpdate = true;
+	ticksMeshNeedsUpdate = true;
+}
+
+void ofxGAxis::formatNumber(float number, string& label) {
+	char buffer[32];
+
+#ifdef OFXG_USE_TO_CHARS
+	char* end = to_chars(buffer, buffer + sizeof(buffer), number, chars_format::general, 6).ptr;
+	label.assign(buffer, end);
+#else
+	int length = snprintf(buffer, sizeof(buffer), "%g", number);
+	label.assign(buffer, length);
+#endif
+}
+
+void ofxGAxis::formatPowerOfTen(int exponent, string& label) {
+	char buffer[16];
+	int length = snprintf(buffer, sizeof(buffer), "1e%d", exponent);
+	label.assign(buffer, length);
 }
 
 void ofxGAxis::updateTickLabels() {
-	stringstream ss;
-	tickLabels.clear();
+	// Reuse the label strings to avoid memory allocations
+	tickLabels.resize(ticks.size());
 
 	if (logScale) {
-		for (float tick : ticks) {
-			float logValue = log10(tick);
+		for (vector<float>::size_type i = 0; i < ticks.size(); ++i) {
+			float logValue = log10(ticks[i]);
 			bool isExactLogValue = abs(logValue - round(logValue)) < 0.0001;
 
 			if (isExactLogValue) {
 				logValue = round(logValue);
 
-				if (expTickLabels) {
-					tickLabels.push_back("1e" + to_string((int) logValue));
+				if (!expTickLabels && logValue > -3.1 && logValue < 3.1) {
+					formatNumber(ticks[i], tickLabels[i]);
 				} else {
-					if (logValue > -3.1 && logValue < 3.1) {
-						ss.str("");
-						ss << std::defaultfloat << tick;
-						tickLabels.push_back(ss.str());
-					} else {
-						tickLabels.push_back("1e" + to_string((int) logValue));
-					}
+					formatPowerOfTen((int) logValue, tickLabels[i]);
 				}
 			} else {
-				tickLabels.push_back("");
+				tickLabels[i].clear();
 			}
 		}
 	} else {
-		for (float tick : ticks) {
-			ss.str("");
-			ss << std::defaultfloat << tick;
-			tickLabels.push_back(ss.str());
+		for (vector<float>::size_type i = 0; i < ticks.size(); ++i) {
+			formatNumber(ticks[i], tickLabels[i]);
+		}
+	}
+
+	updateTickLabelsBounds();
+}
+
+void ofxGAxis::updateTicksMesh() const {
+	ticksMesh.clear();
+	ticksMesh.setMode(OF_PRIMITIVE_LINES);
+	vector<glm::vec3>& meshVertices = ticksMesh.getVertices();
+
+	// Work with positions along the axis and perpendicular to it, pointing away from the plot box
+	bool isHorizontal = type == GRAFICA_X_AXIS || type == GRAFICA_TOP_AXIS;
+	float direction = (type == GRAFICA_X_AXIS || type == GRAFICA_RIGHT_AXIS) ? 1 : -1;
+	float axisLength = isHorizontal ? dim[0] : -dim[1];
+	auto addLine = [&](float along1, float perp1, float along2, float perp2) {
+		meshVertices.push_back(isHorizontal ? glm::vec3(along1, perp1, 0) : glm::vec3(perp1, along1, 0));
+		meshVertices.push_back(isHorizontal ? glm::vec3(along2, perp2, 0) : glm::vec3(perp2, along2, 0));
+	};
+
+	// Add the axis line and the ticks inside the axis limits
+	addLine(0, direction * offset, axisLength, direction * offset);
+
+	for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
+		if (ticksInside[i]) {
+			float length = (logScale && tickLabels[i].empty()) ? smallTickLength : tickLength;
+			addLine(plotTicks[i], direction * offset, plotTicks[i], direction * (offset + length));
+		}
+	}
+
+	ticksMeshNeedsUpdate = false;
+}
+
+void ofxGAxis::drawTicksMesh() const {
+	if (ticksMeshNeedsUpdate) {
+		updateTicksMesh();
+	}
+
+	ticksMesh.draw();
+}
+
+void ofxGAxis::updateTickLabelsBounds() {
+	tickLabelsBounds.clear();
+
+	for (const string& label : tickLabels) {
+		tickLabelsBounds.push_back(label.empty() ? ofRectangle() : font->getStringBoundingBox(label, 0, 0));
+	}
+
+	tickLabelsMeshNeedsUpdate = true;
+	ticksMeshNeedsUpdate = true;
+}
+
+void ofxGAxis::updateTickLabelsMesh() const {
+	tickLabelsMesh.clear();
+	tickLabelsMesh.setMode(OF_PRIMITIVE_TRIANGLES);
+
+	for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
+		if (ticksInside[i] && !tickLabels[i].empty()) {
+			// Calculate the label position
+			const ofRectangle& bounds = tickLabelsBounds[i];
+			float x = 0;
+			float y = 0;
+
+			switch (type) {
+			case GRAFICA_X_AXIS:
+				x = rotateTickLabels ? plotTicks[i] + fontSize / 2.0 : plotTicks[i] - bounds.width / 2;
+				y = rotateTickLabels ? offset + tickLabelOffset + bounds.width : offset + tickLabelOffset + fontSize;
+				break;
+			case GRAFICA_Y_AXIS:
+				x = rotateTickLabels ? -offset - tickLabelOffset : -offset - tickLabelOffset - bounds.width;
+				y = rotateTickLabels ? plotTicks[i] + bounds.width / 2 : plotTicks[i] + fontSize / 2.0;
+				break;
+			case GRAFICA_TOP_AXIS:
+				x = rotateTickLabels ? plotTicks[i] + fontSize / 2.0 : plotTicks[i] - bounds.width / 2;
+				y = -offset - tickLabelOffset;
+				break;
+			case GRAFICA_RIGHT_AXIS:
+				x = rotateTickLabels ? offset + tickLabelOffset + fontSize : offset + tickLabelOffset;
+				y = rotateTickLabels ? plotTicks[i] + bounds.width / 2 : plotTicks[i] + fontSize / 2.0;
+				break;
+			}
+
+			// Add the label glyphs, rotated if necessary
+			ofMesh labelMesh = font->getStringMesh(tickLabels[i], 0, 0);
+
+			for (glm::vec3& v : labelMesh.getVertices()) {
+				v = rotateTickLabels ? glm::vec3(x + v.y, y - v.x, 0) : glm::vec3(x + v.x, y + v.y, 0);
+			}
+
+			tickLabelsMesh.append(labelMesh);
 		}
 	}
+
+	tickLabelsMeshNeedsUpdate = false;
+}
+
+void ofxGAxis::drawTickLabelsMesh() const {
+	if (tickLabelsMeshNeedsUpdate) {
+		updateTickLabelsMesh();
+	}
+
+	font->getFontTexture().bind();
+	tickLabelsMesh.draw();
+	font->getFontTexture().unbind();
 }
 
 void ofxGAxis::moveLim(const array<float, 2>& newLim) {
@@ -303,44 +432,13 @@ void ofxGAxis::drawAsXAxis() const {
 	ofSetColor(lineColor);
 	ofSetLineWidth(lineWidth);
 
-	// Draw the ticks
-	ofDrawLine(0, offset, dim[0], offset);
-
-	for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-		if (ticksInside[i]) {
-			if (logScale && tickLabels[i] == "") {
-				ofDrawLine(plotTicks[i], offset, plotTicks[i], offset + smallTickLength);
-			} else {
-				ofDrawLine(plotTicks[i], offset, plotTicks[i], offset + tickLength);
-			}
-		}
-	}
+	// Draw the axis line and the ticks
+	drawTicksMesh();
 
 	// Draw the tick labels
 	if (drawTickLabels) {
 		ofSetColor(fontColor);
-
-		if (rotateTickLabels) {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-
-					ofPushMatrix();
-					ofTranslate(plotTicks[i] + fontSize / 2.0, offset + tickLabelOffset + bounds.width);
-					ofRotateZDeg(-90);
-					font.drawString(tickLabels[i], 0, 0);
-					ofPopMatrix();
-				}
-			}
-		} else {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-					font.drawString(tickLabels[i], plotTicks[i] - bounds.width / 2,
-							offset + tickLabelOffset + fontSize);
-				}
-			}
-		}
+		drawTickLabelsMesh();
 	}
 
 	ofPopStyle();
@@ -351,44 +449,13 @@ void ofxGAxis::drawAsYAxis() const {
 	ofSetColor(lineColor);
 	ofSetLineWidth(lineWidth);
 
-	// Draw the ticks
-	ofDrawLine(-offset, 0, -offset, -dim[1]);
-
-	for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-		if (ticksInside[i]) {
-			if (logScale && tickLabels[i] == "") {
-				ofDrawLine(-offset, plotTicks[i], -offset - smallTickLength, plotTicks[i]);
-			} else {
-				ofDrawLine(-offset, plotTicks[i], -offset - tickLength, plotTicks[i]);
-			}
-		}
-	}
+	// Draw the axis line and the ticks
+	drawTicksMesh();
 
 	// Draw the tick labels
 	if (drawTickLabels) {
 		ofSetColor(fontColor);
-
-		if (rotateTickLabels) {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-
-					ofPushMatrix();
-					ofTranslate(-offset - tickLabelOffset, plotTicks[i] + bounds.width / 2);
-					ofRotateZDeg(-90);
-					font.drawString(tickLabels[i], 0, 0);
-					ofPopMatrix();
-				}
-			}
-		} else {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-					font.drawString(tickLabels[i], -offset - tickLabelOffset - bounds.width,
-							plotTicks[i] + fontSize / 2.0);
-				}
-			}
-		}
+		drawTickLabelsMesh();
 	}
 
 	ofPopStyle();
@@ -402,41 +469,13 @@ void ofxGAxis::drawAsTopAxis() const {
 	ofPushMatrix();
 	ofTranslate(0, -dim[1]);
 
-	// Draw the ticks
-	ofDrawLine(0, -offset, dim[0], -offset);
-
-	for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-		if (ticksInside[i]) {
-			if (logScale && tickLabels[i] == "") {
-				ofDrawLine(plotTicks[i], -offset, plotTicks[i], -offset - smallTickLength);
-			} else {
-				ofDrawLine(plotTicks[i], -offset, plotTicks[i], -offset - tickLength);
-			}
-		}
-	}
+	// Draw the axis line and the ticks
+	drawTicksMesh();
 
 	// Draw the tick labels
 	if (drawTickLabels) {
 		ofSetColor(fontColor);
-
-		if (rotateTickLabels) {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofPushMatrix();
-					ofTranslate(plotTicks[i] + fontSize / 2.0, -offset - tickLabelOffset);
-					ofRotateZDeg(-90);
-					font.drawString(tickLabels[i], 0, 0);
-					ofPopMatrix();
-				}
-			}
-		} else {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-					font.drawString(tickLabels[i], plotTicks[i] - bounds.width / 2, -offset - tickLabelOffset);
-				}
-			}
-		}
+		drawTickLabelsMesh();
 	}
 
 	ofPopMatrix();
@@ -451,43 +490,13 @@ void ofxGAxis::drawAsRightAxis() const {
 	ofPushMatrix();
 	ofTranslate(dim[0], 0);
 
-	// Draw the ticks
-	ofDrawLine(offset, 0, offset, -dim[1]);
-
-	for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-		if (ticksInside[i]) {
-			if (logScale && tickLabels[i] == "") {
-				ofDrawLine(offset, plotTicks[i], offset + smallTickLength, plotTicks[i]);
-			} else {
-				ofDrawLine(offset, plotTicks[i], offset + tickLength, plotTicks[i]);
-			}
-		}
-	}
+	// Draw the axis line and the ticks
+	drawTicksMesh();
 
 	// Draw the tick labels
 	if (drawTickLabels) {
 		ofSetColor(fontColor);
-
-		if (rotateTickLabels) {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-
-					ofPushMatrix();
-					ofTranslate(offset + tickLabelOffset + fontSize, plotTicks[i] + bounds.width / 2);
-					ofRotateZDeg(-90);
-					font.drawString(tickLabels[i], 0, 0);
-					ofPopMatrix();
-				}
-			}
-		} else {
-			for (vector<float>::size_type i = 0; i < plotTicks.size(); ++i) {
-				if (ticksInside[i] && tickLabels[i] != "") {
-					ofRectangle bounds = font.getStringBoundingBox(tickLabels[i], 0, 0);
-					font.drawString(tickLabels[i], offset + tickLabelOffset, plotTicks[i] + fontSize / 2.0);
-				}
-			}
-		}
+		drawTickLabelsMesh();
 	}
 
 	ofPopMatrix();
@@ -568,6 +577,8 @@ void ofxGAxis::setLogScale(bool newLogScale) {
 
 void ofxGAxis::setOffset(float newOffset) {
 	offset = newOffset;
+	ticksMeshNeedsUpdate = true;
+	tickLabelsMeshNeedsUpdate = true;
 }
 
 void ofxGAxis::setLineColor(const ofColor& newLineColor) {
@@ -626,6 +637,7 @@ void ofxGAxis::setTickLabels(const vector<string>& newTickLabels) {
 
 	fixedTicks = true;
 	tickLabels = newTickLabels;
+	updateTickLabelsBounds();
 }
 
 void ofxGAxis::setFixedTicks(bool newFixedTicks) {
@@ -643,10 +655,12 @@ void ofxGAxis::setFixedTicks(bool newFixedTicks) {
 
 void ofxGAxis::setTickLength(float newTickLength) {
 	tickLength = newTickLength;
+	ticksMeshNeedsUpdate = true;
 }
 
 void ofxGAxis::setSmallTickLength(float newSmallTickLength) {
 	smallTickLength = newSmallTickLength;
+	ticksMeshNeedsUpdate = true;
 }
 
 void ofxGAxis::setExpTickLabels(bool newExpTickLabels) {
@@ -658,6 +672,7 @@ void ofxGAxis::setExpTickLabels(bool newExpTickLabels) {
 
 void ofxGAxis::setRotateTickLabels(bool newRotateTickLabels) {
 	rotateTickLabels = newRotateTickLabels;
+	tickLabelsMeshNeedsUpdate = true;
 }
 
 void ofxGAxis::setDrawTickLabels(bool newDrawTicksLabels) {
@@ -666,6 +681,7 @@ void ofxGAxis::setDrawTickLabels(bool newDrawTicksLabels) {
 
 void ofxGAxis::setTickLabelOffset(float newTickLabelOffset) {
 	tickLabelOffset = newTickLabelOffset;
+	tickLabelsMeshNeedsUpdate = true;
 }
 
 void ofxGAxis::setDrawAxisLabel(bool newDrawAxisLabel) {
@@ -678,7 +694,8 @@ void ofxGAxis::setAxisLabelText(const string& text) {
 
 void ofxGAxis::setFontName(const string& newFontName) {
 	fontName = newFontName;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
+	updateTickLabelsBounds();
 }
 
 void ofxGAxis::setFontColor(const ofColor& newFontColor) {
@@ -691,7 +708,8 @@ void ofxGAxis::setFontSize(int newFontSize) {
 	}
 
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
+	updateTickLabelsBounds();
 }
 
 void ofxGAxis::setFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -702,7 +720,8 @@ void ofxGAxis::setFontProperties(const string& newFontName, const ofColor& newFo
 	fontName = newFontName;
 	fontColor = newFontColor;
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
+	updateTickLabelsBounds();
 }
 
 void ofxGAxis::setAllFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -712,7 +731,8 @@ void ofxGAxis::setAllFontProperties(const string& newFontName, const ofColor& ne
 
 void ofxGAxis::setFontsMakeContours(bool newFontMakeContours) {
 	fontMakeContours = newFontMakeContours;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
+	updateTickLabelsBounds();
 	lab.setFontMakeContours(fontMakeContours);
 }
 
@@ -288,6 +288,24 @@ protected:
 	 */
 	static float roundPlus(float number, int sigDigits);
 
+	/**
+	 * @brief Formats a number like a stream with the default float format and 6 digits precision
+	 *
+	 * The label is assigned in place, so short labels don't allocate memory
+	 *
+	 * @param number the number to format
+	 * @param label the string where the formatted number will be saved
+	 */
+	static void formatNumber(float number, string& label);
+
+	/**
+	 * @brief Formats a power of ten in exponential notation (1eX)
+	 *
+	 * @param exponent the power of ten exponent
+	 * @param label the string where the formatted number will be saved
+	 */
+	static void formatPowerOfTen(int exponent, string& label);
+
 	/**
 	 * @brief Updates the axis ticks
 	 */
@@ -318,6 +336,31 @@ protected:
 	 */
 	void updateTickLabels();
 
+	/**
+	 * @brief Rebuilds the mesh with the axis line and the ticks inside the axis limits
+	 */
+	void updateTicksMesh() const;
+
+	/**
+	 * @brief Draws the axis line and ticks mesh, rebuilding it first if it's outdated
+	 */
+	void drawTicksMesh() const;
+
+	/**
+	 * @brief Updates the tick label bounds. It should be called when the tick labels or the font change
+	 */
+	void updateTickLabelsBounds();
+
+	/**
+	 * @brief Rebuilds the mesh with the glyphs of the tick labels inside the axis limits
+	 */
+	void updateTickLabelsMesh() const;
+
+	/**
+	 * @brief Draws the tick labels mesh, rebuilding it first if it's outdated
+	 */
+	void drawTickLabelsMesh() const;
+
 	/**
 	 * @brief Draws the axis as an X axis
 	 */
@@ -403,6 +446,33 @@ protected:
 	 */
 	vector<string> tickLabels;
 
+	/**
+	 * @brief The mesh with the axis line and the ticks inside the axis limits
+	 */
+	mutable ofVboMesh ticksMesh;
+
+	/**
+	 * @brief Defines if the ticks mesh should be rebuilt before drawing it. It's set when the ticks, the tick labels
+	 * bounds, the offset or the tick lengths change
+	 */
+	mutable bool ticksMeshNeedsUpdate;
+
+	/**
+	 * @brief The bounding boxes of the tick labels
+	 */
+	vector<ofRectangle> tickLabelsBounds;
+
+	/**
+	 * @brief The mesh with the glyphs of the tick labels inside the axis limits
+	 */
+	mutable ofVboMesh tickLabelsMesh;
+
+	/**
+	 * @brief Defines if the tick labels mesh should be rebuilt before drawing it. It's set when the ticks, the tick
+	 * labels, the font, the offset or the labels orientation change
+	 */
+	mutable bool tickLabelsMeshNeedsUpdate;
+
 	/**
 	 * @brief Defines if the axis ticks are fixed or not
 	 */
@@ -469,7 +539,7 @@ protected:
 	bool fontMakeContours;
 
 	/**
-	 * @brief The trueType font
+	 * @brief The trueType font. It is shared with the other plot components that use the same font properties
 	 */
-	ofTrueTypeFont font;
+	shared_ptr<ofTrueTypeFont> font;
 };
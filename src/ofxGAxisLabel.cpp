@@ -1,5 +1,6 @@
 #include "ofxGAxisLabel.h"
 #include "ofxGConstants.h"
+#include "ofxGFontRegistry.h"
 #include "ofMain.h"
 
 ofxGAxisLabel::ofxGAxisLabel(ofxGAxisType _type, const array<float, 2>& _dim, const string& _text) :
@@ -16,7 +17,7 @@ ofxGAxisLabel::ofxGAxisLabel(ofxGAxisType _type, const array<float, 2>& _dim, co
 	fontColor = ofColor(0);
 	fontSize = 10;
 	fontMakeContours = false;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGAxisLabel::draw() const {
@@ -39,27 +40,27 @@ void ofxGAxisLabel::draw() const {
 void ofxGAxisLabel::drawAsXLabel() const {
 	ofPushStyle();
 	ofSetColor(fontColor);
-	ofRectangle bounds = font.getStringBoundingBox(text, 0, 0);
+	ofRectangle bounds = font->getStringBoundingBox(text, 0, 0);
 
 	if (rotate) {
 		ofPushMatrix();
 		ofTranslate(plotPos + fontSize / 2.0, offset + bounds.width);
 		ofRotateZDeg(-90);
-		font.drawString(text, 0, 0);
+		font->drawString(text, 0, 0);
 		ofPopMatrix();
 	} else {
 		switch (textAlignment) {
 		case GRAFICA_CENTER_ALIGN:
-			font.drawString(text, plotPos - bounds.width / 2, offset + fontSize);
+			font->drawString(text, plotPos - bounds.width / 2, offset + fontSize);
 			break;
 		case GRAFICA_LEFT_ALIGN:
-			font.drawString(text, plotPos, offset + fontSize);
+			font->drawString(text, plotPos, offset + fontSize);
 			break;
 		case GRAFICA_RIGHT_ALIGN:
-			font.drawString(text, plotPos - bounds.width, offset + fontSize);
+			font->drawString(text, plotPos - bounds.width, offset + fontSize);
 			break;
 		default:
-			font.drawString(text, plotPos - bounds.width / 2, offset + fontSize);
+			font->drawString(text, plotPos - bounds.width / 2, offset + fontSize);
 			break;
 		}
 	}
@@ -70,7 +71,7 @@ void ofxGAxisLabel::drawAsXLabel() const {
 void ofxGAxisLabel::drawAsYLabel() const {
 	ofPushStyle();
 	ofSetColor(fontColor);
-	ofRectangle bounds = font.getStringBoundingBox(text, 0, 0);
+	ofRectangle bounds = font->getStringBoundingBox(text, 0, 0);
 
 	if (rotate) {
 		ofPushMatrix();
@@ -91,10 +92,10 @@ void ofxGAxisLabel::drawAsYLabel() const {
 		}
 
 		ofRotateZDeg(-90);
-		font.drawString(text, 0, 0);
+		font->drawString(text, 0, 0);
 		ofPopMatrix();
 	} else {
-		font.drawString(text, -offset - bounds.width, plotPos + fontSize / 2.0);
+		font->drawString(text, -offset - bounds.width, plotPos + fontSize / 2.0);
 	}
 
 	ofPopStyle();
@@ -103,27 +104,27 @@ void ofxGAxisLabel::drawAsYLabel() const {
 void ofxGAxisLabel::drawAsTopLabel() const {
 	ofPushStyle();
 	ofSetColor(fontColor);
-	ofRectangle bounds = font.getStringBoundingBox(text, 0, 0);
+	ofRectangle bounds = font->getStringBoundingBox(text, 0, 0);
 
 	if (rotate) {
 		ofPushMatrix();
 		ofTranslate(plotPos + fontSize / 2.0, -offset - dim[1]);
 		ofRotateZDeg(-90);
-		font.drawString(text, 0, 0);
+		font->drawString(text, 0, 0);
 		ofPopMatrix();
 	} else {
 		switch (textAlignment) {
 		case GRAFICA_CENTER_ALIGN:
-			font.drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
+			font->drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
 			break;
 		case GRAFICA_LEFT_ALIGN:
-			font.drawString(text, plotPos, -offset - dim[1]);
+			font->drawString(text, plotPos, -offset - dim[1]);
 			break;
 		case GRAFICA_RIGHT_ALIGN:
-			font.drawString(text, plotPos - bounds.width, -offset - dim[1]);
+			font->drawString(text, plotPos - bounds.width, -offset - dim[1]);
 			break;
 		default:
-			font.drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
+			font->drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
 			break;
 		}
 	}
@@ -134,7 +135,7 @@ void ofxGAxisLabel::drawAsTopLabel() const {
 void ofxGAxisLabel::drawAsRightLabel() const {
 	ofPushStyle();
 	ofSetColor(fontColor);
-	ofRectangle bounds = font.getStringBoundingBox(text, 0, 0);
+	ofRectangle bounds = font->getStringBoundingBox(text, 0, 0);
 
 	if (rotate) {
 		ofPushMatrix();
@@ -155,10 +156,10 @@ void ofxGAxisLabel::drawAsRightLabel() const {
 		}
 
 		ofRotateZDeg(-90);
-		font.drawString(text, 0, 0);
+		font->drawString(text, 0, 0);
 		ofPopMatrix();
 	} else {
-		font.drawString(text, offset + dim[0], plotPos + fontSize / 2.0);
+		font->drawString(text, offset + dim[0], plotPos + fontSize / 2.0);
 	}
 
 	ofPopStyle();
@@ -200,7 +201,7 @@ void ofxGAxisLabel::setTextAlignment(ofxGTextAlignment newTextAlignment) {
 
 void ofxGAxisLabel::setFontName(const string& newFontName) {
 	fontName = newFontName;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGAxisLabel::setFontColor(const ofColor& newFontColor) {
@@ -213,7 +214,7 @@ void ofxGAxisLabel::setFontSize(int newFontSize) {
 	}
 
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGAxisLabel::setFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -224,10 +225,10 @@ void ofxGAxisLabel::setFontProperties(const string& newFontName, const ofColor&
 	fontName = newFontName;
 	fontColor = newFontColor;
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGAxisLabel::setFontMakeContours(bool newFontMakeContours) {
 	fontMakeContours = newFontMakeContours;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
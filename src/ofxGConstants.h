@@ -41,3 +41,17 @@ enum ofxGContourType {
 enum ofxGKeyModifiers {
 	GRAFICA_NONE_MODIFIER = -1
 };
+
+/**
+ * @brief ofxGrafica plot box borders
+ */
+enum ofxGBoxBorder {
+	GRAFICA_LEFT_BORDER, GRAFICA_RIGHT_BORDER, GRAFICA_BOTTOM_BORDER, GRAFICA_TOP_BORDER
+};
+
+/**
+ * @brief ofxGrafica contour shape vertex types
+ */
+enum ofxGShapeVertexType {
+	GRAFICA_POINT_VERTEX, GRAFICA_PROJECTION_VERTEX, GRAFICA_CUT_VERTEX, GRAFICA_EXTREME_VERTEX
+};
@@ -0,0 +1,426 @@
+#include "ofxGDataSource.h"
+#include "ofxGPointSpan.h"
+#include "ofxGLayer.h"
+#include "ofMain.h"
+
+#ifdef TARGET_WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ofxGDataSource::ofxGDataSource() :
+		numRows(0), xColumn(0), yColumn(1) {
+}
+
+ofxGDataSource::~ofxGDataSource() {
+	close();
+}
+
+bool ofxGDataSource::load(const string& path) {
+	close();
+
+	return addFile(path);
+}
+
+bool ofxGDataSource::addFile(const string& path) {
+	MappedFile file;
+
+	if (!mapFile(ofToDataPath(path, true), file)) {
+		ofLogError("Couldn't map the file " + path);
+		return false;
+	}
+
+	// Obtain the file columns. The format is identified by the file magic string
+	vector<Column> fileColumns;
+	size_t fileNumRows = 0;
+	bool isValid = false;
+
+	if (file.size >= 8 && memcmp(file.data, "OFXGCOLS", 8) == 0) {
+		isValid = parseColumnarFile(file, fileColumns, fileNumRows);
+	} else if (file.size >= 6 && memcmp(file.data, "\x93NUMPY", 6) == 0) {
+		isValid = parseNpyFile(file, ofFilePath::getBaseName(path), fileColumns, fileNumRows);
+	}
+
+	if (!isValid) {
+		ofLogError("The file " + path + " is not a valid .npy or columnar file");
+		unmapFile(file);
+		return false;
+	} else if (!columns.empty() && fileNumRows != numRows) {
+		ofLogError("The file " + path + " has a different number of rows than the other files");
+		unmapFile(file);
+		return false;
+	}
+
+	// The file is unmapped when the data source and all the layer spans that use it release it
+	shared_ptr<const MappedFile> sharedFile(new MappedFile(file), [](const MappedFile* f) {
+		unmapFile(*f);
+		delete f;
+	});
+
+	for (Column& column : fileColumns) {
+		column.file = sharedFile;
+	}
+
+	files.push_back(sharedFile);
+	columns.insert(columns.end(), fileColumns.begin(), fileColumns.end());
+	numRows = fileNumRows;
+
+	return true;
+}
+
+void ofxGDataSource::close() {
+	// The files still used by some layers are unmapped when the layers release them
+	files.clear();
+	columns.clear();
+	numRows = 0;
+}
+
+void ofxGDataSource::updateLayer(ofxGLayer& layer, const array<float, 2>& xLim) {
+	if (xColumn >= columns.size() || yColumn >= columns.size()) {
+		throw invalid_argument("The data source doesn't have the selected x and y columns.");
+	}
+
+	// Find the visible rows and their closest neighbours, so the lines reach the plot box borders
+	size_t first = lowerBoundX(min(xLim[0], xLim[1]));
+	size_t last = upperBoundX(max(xLim[0], xLim[1]));
+	first = (first > 0) ? first - 1 : first;
+	last = (last < numRows) ? last + 1 : last;
+
+	// Pass the float32 columns directly to the layer. The span shares the ownership of the mapped files, so they
+	// stay mapped while the layer uses them
+	const Column& x = columns[xColumn];
+	const Column& y = columns[yColumn];
+	size_t n = last - first;
+
+	if (x.elementSize == sizeof(float) && y.elementSize == sizeof(float) && x.stride == y.stride) {
+		ofxGPointSpan span(reinterpret_cast<const float*>(x.data + first * x.stride),
+				reinterpret_cast<const float*>(y.data + first * y.stride), n, x.stride);
+		span.setOwner(make_shared<array<shared_ptr<const MappedFile>, 2>>(
+				array<shared_ptr<const MappedFile>, 2> { x.file, y.file }));
+		layer.setPoints(span);
+	} else {
+		// Copy the visible rows to the layer, converting them to float
+		vector<ofxGPoint> windowPoints;
+		windowPoints.reserve(n);
+
+		for (size_t i = first; i < last; ++i) {
+			windowPoints.emplace_back(getValue(x, i), getValue(y, i));
+		}
+
+		layer.setPoints(windowPoints);
+	}
+}
+
+void ofxGDataSource::setColumns(size_t newXColumn, size_t newYColumn) {
+	if (newXColumn >= columns.size() || newYColumn >= columns.size()) {
+		throw invalid_argument("The column index should be smaller than the number of columns.");
+	}
+
+	xColumn = newXColumn;
+	yColumn = newYColumn;
+}
+
+void ofxGDataSource::setColumns(const string& xColumnName, const string& yColumnName) {
+	int newXColumn = getColumnIndex(xColumnName);
+	int newYColumn = getColumnIndex(yColumnName);
+
+	if (newXColumn < 0 || newYColumn < 0) {
+		throw invalid_argument("Couldn't find a column with the given name.");
+	}
+
+	setColumns(newXColumn, newYColumn);
+}
+
+size_t ofxGDataSource::getNumRows() const {
+	return numRows;
+}
+
+size_t ofxGDataSource::getNumColumns() const {
+	return columns.size();
+}
+
+const string& ofxGDataSource::getColumnName(size_t column) const {
+	return columns.at(column).name;
+}
+
+int ofxGDataSource::getColumnIndex(const string& name) const {
+	for (size_t i = 0; i < columns.size(); ++i) {
+		if (columns[i].name == name) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+array<float, 2> ofxGDataSource::getXLim() const {
+	if (numRows == 0 || xColumn >= columns.size()) {
+		return {numeric_limits<float>::infinity(), -numeric_limits<float>::infinity()};
+	}
+
+	return {float(getValue(columns[xColumn], 0)), float(getValue(columns[xColumn], numRows - 1))};
+}
+
+bool ofxGDataSource::mapFile(const string& path, MappedFile& file) {
+#ifdef TARGET_WIN32
+	HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	// The view keeps the mapping alive after the handles are closed
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(fileHandle);
+
+	if (mappingHandle == nullptr) {
+		return false;
+	}
+
+	void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mappingHandle);
+
+	if (view == nullptr) {
+		return false;
+	}
+
+	file.data = static_cast<const uint8_t*>(view);
+	file.size = fileSize.QuadPart;
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat fileStat;
+
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	// The mapping stays valid after the file descriptor is closed
+	void* view = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	file.data = static_cast<const uint8_t*>(view);
+	file.size = fileStat.st_size;
+#endif
+
+	return true;
+}
+
+void ofxGDataSource::unmapFile(const MappedFile& file) {
+#ifdef TARGET_WIN32
+	UnmapViewOfFile(file.data);
+#else
+	munmap(const_cast<uint8_t*>(file.data), file.size);
+#endif
+}
+
+bool ofxGDataSource::parseColumnarFile(const MappedFile& file, vector<Column>& fileColumns, size_t& fileNumRows) {
+	const size_t headerSize = 24;
+	const size_t descriptorSize = 48;
+
+	if (file.size < headerSize) {
+		return false;
+	}
+
+	uint64_t nRows;
+	uint32_t nColumns;
+	memcpy(&nRows, file.data + 8, sizeof(nRows));
+	memcpy(&nColumns, file.data + 16, sizeof(nColumns));
+
+	if (file.size < headerSize + nColumns * descriptorSize) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < nColumns; ++i) {
+		const uint8_t* descriptor = file.data + headerSize + i * descriptorSize;
+		const char* name = reinterpret_cast<const char*>(descriptor);
+		uint64_t offset;
+		uint32_t elementSize;
+		memcpy(&offset, descriptor + 32, sizeof(offset));
+		memcpy(&elementSize, descriptor + 40, sizeof(elementSize));
+
+		// Check that the column fits inside the file
+		if ((elementSize != 4 && elementSize != 8) || offset > file.size
+				|| nRows > (file.size - offset) / elementSize) {
+			return false;
+		}
+
+		fileColumns.push_back({string(name, find(name, name + 32, '\0')), file.data + offset, elementSize,
+				elementSize, nullptr});
+	}
+
+	fileNumRows = nRows;
+
+	return true;
+}
+
+bool ofxGDataSource::parseNpyFile(const MappedFile& file, const string& name, vector<Column>& fileColumns,
+		size_t& fileNumRows) {
+	// The header length is stored in 2 bytes in version 1 and in 4 bytes in later versions
+	if (file.size < 12) {
+		return false;
+	}
+
+	uint8_t majorVersion = file.data[6];
+	size_t headerStart = (majorVersion == 1) ? 10 : 12;
+	size_t headerLength;
+
+	if (majorVersion == 1) {
+		uint16_t length;
+		memcpy(&length, file.data + 8, sizeof(length));
+		headerLength = length;
+	} else {
+		uint32_t length;
+		memcpy(&length, file.data + 8, sizeof(length));
+		headerLength = length;
+	}
+
+	if (file.size < headerStart + headerLength) {
+		return false;
+	}
+
+	// The header is a python dictionary with the data type, the data order and the array shape
+	string header(reinterpret_cast<const char*>(file.data + headerStart), headerLength);
+	size_t descrPos = header.find("'descr'");
+	size_t orderPos = header.find("'fortran_order'");
+	size_t shapePos = header.find("'shape'");
+
+	if (descrPos == string::npos || orderPos == string::npos || shapePos == string::npos) {
+		return false;
+	}
+
+	size_t descrStart = header.find('\'', descrPos + 7);
+	size_t descrEnd = (descrStart == string::npos) ? string::npos : header.find('\'', descrStart + 1);
+	size_t orderStart = header.find_first_not_of(" :", orderPos + 15);
+	size_t shapeStart = header.find('(', shapePos);
+	size_t shapeEnd = (shapeStart == string::npos) ? string::npos : header.find(')', shapeStart);
+
+	if (descrEnd == string::npos || orderStart == string::npos || shapeEnd == string::npos) {
+		return false;
+	}
+
+	string descr = header.substr(descrStart + 1, descrEnd - descrStart - 1);
+	size_t elementSize;
+
+	if (descr == "<f4" || descr == "=f4") {
+		elementSize = 4;
+	} else if (descr == "<f8" || descr == "=f8") {
+		elementSize = 8;
+	} else {
+		return false;
+	}
+
+	bool fortranOrder = header.compare(orderStart, 4, "True") == 0;
+	vector<string> shapeValues = ofSplitString(header.substr(shapeStart + 1, shapeEnd - shapeStart - 1), ",", true,
+			true);
+
+	if (shapeValues.empty() || shapeValues.size() > 2) {
+		return false;
+	}
+
+	for (const string& value : shapeValues) {
+		if (!all_of(value.begin(), value.end(), ::isdigit)) {
+			return false;
+		}
+	}
+
+	size_t nRows = stoull(shapeValues[0]);
+	size_t nColumns = (shapeValues.size() == 2) ? stoull(shapeValues[1]) : 1;
+	size_t dataStart = headerStart + headerLength;
+
+	if (nColumns > 0 && nRows > (file.size - dataStart) / elementSize / nColumns) {
+		return false;
+	}
+
+	// The columns are contiguous in Fortran order and interleaved in C order
+	for (size_t i = 0; i < nColumns; ++i) {
+		string columnName = (nColumns == 1) ? name : name + "_" + ofToString(i);
+
+		if (fortranOrder || nColumns == 1) {
+			fileColumns.push_back({columnName, file.data + dataStart + i * nRows * elementSize, elementSize,
+					elementSize, nullptr});
+		} else {
+			fileColumns.push_back({columnName, file.data + dataStart + i * elementSize, nColumns * elementSize,
+					elementSize, nullptr});
+		}
+	}
+
+	fileNumRows = nRows;
+
+	return true;
+}
+
+double ofxGDataSource::getValue(const Column& column, size_t row) {
+	const uint8_t* element = column.data + row * column.stride;
+
+	if (column.elementSize == sizeof(float)) {
+		float value;
+		memcpy(&value, element, sizeof(value));
+
+		return value;
+	}
+
+	double value;
+	memcpy(&value, element, sizeof(value));
+
+	return value;
+}
+
+size_t ofxGDataSource::lowerBoundX(double value) const {
+	const Column& x = columns[xColumn];
+	size_t first = 0;
+	size_t n = numRows;
+
+	while (n > 0) {
+		size_t half = n / 2;
+
+		if (getValue(x, first + half) < value) {
+			first += half + 1;
+			n -= half + 1;
+		} else {
+			n = half;
+		}
+	}
+
+	return first;
+}
+
+size_t ofxGDataSource::upperBoundX(double value) const {
+	const Column& x = columns[xColumn];
+	size_t first = 0;
+	size_t n = numRows;
+
+	while (n > 0) {
+		size_t half = n / 2;
+
+		if (getValue(x, first + half) <= value) {
+			first += half + 1;
+			n -= half + 1;
+		} else {
+			n = half;
+		}
+	}
+
+	return first;
+}
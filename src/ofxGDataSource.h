@@ -0,0 +1,284 @@
+#pragma once
+
+#include "ofxGPointSpan.h"
+#include "ofxGLayer.h"
+#include "ofMain.h"
+
+/**
+ * @brief Data source class
+ *
+ * An ofxGDataSource memory-maps one or more binary files with columns of float32 or float64 values and feeds a layer
+ * with the rows that fall inside the visible x range. The files are never read as a whole: the operating system only
+ * loads the pages that are touched, which are the few pages needed to find the visible rows in the x column and the
+ * pages of the visible rows themselves.
+ *
+ * Two file formats are supported (both little-endian):
+ *
+ * - NumPy .npy files with a one or two dimensional float32 ('<f4') or float64 ('<f8') array, in C or Fortran order.
+ * The rows of a two dimensional array are the data rows. Several files with the same number of rows can be combined,
+ * for example an x.npy and a y.npy file.
+ * - Columnar files: the 8 characters "OFXGCOLS", the number of rows (uint64), the number of columns (uint32), 4
+ * reserved bytes and one 48 bytes descriptor per column. Each descriptor contains the column name (32 characters,
+ * padded with zeros), the position of the column data in the file (uint64), the size of the column elements (uint32,
+ * 4 or 8) and 4 reserved bytes. The column data is stored contiguously.
+ *
+ * The x column should be sorted in increasing order. The float32 columns are passed to the layer without copying them,
+ * while the visible rows of the float64 columns are converted to float and copied to the layer. The layers share the
+ * ownership of the mapped files, so a file stays mapped after the data source is closed or destroyed, until no layer
+ * uses it anymore.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGDataSource {
+public:
+
+	/**
+	 * @brief Constructor
+	 */
+	ofxGDataSource();
+
+	/**
+	 * @brief Destructor. Unmaps the files that are not used by any layer
+	 */
+	~ofxGDataSource();
+
+	/**
+	 * @brief The data source owns the mapped files, so it can't be copied
+	 */
+	ofxGDataSource(const ofxGDataSource&) = delete;
+
+	/**
+	 * @brief The data source owns the mapped files, so it can't be copied
+	 */
+	ofxGDataSource& operator=(const ofxGDataSource&) = delete;
+
+	/**
+	 * @brief Closes the current files and maps a new one
+	 *
+	 * @param path the path to the .npy or columnar file, relative to the data folder
+	 *
+	 * @return true if the file could be mapped and has a valid format
+	 */
+	bool load(const string& path);
+
+	/**
+	 * @brief Maps a file and adds its columns to the data source. The file should have the same number of rows as the
+	 * files already in the data source
+	 *
+	 * @param path the path to the .npy or columnar file, relative to the data folder
+	 *
+	 * @return true if the file could be mapped and has a valid format
+	 */
+	bool addFile(const string& path);
+
+	/**
+	 * @brief Removes all the files and columns. The files are unmapped when no layer uses them anymore
+	 */
+	void close();
+
+	/**
+	 * @brief Feeds a layer with the rows that are inside a given x range and their closest neighbours
+	 *
+	 * The layer points are replaced on every call, so it's usually called only when the x range changes.
+	 *
+	 * @param layer the layer to feed
+	 * @param xLim the visible x range, usually the plot x limits
+	 */
+	void updateLayer(ofxGLayer& layer, const array<float, 2>& xLim);
+
+	/**
+	 * @brief Sets the columns that should be used as the x and y coordinates
+	 *
+	 * @param newXColumn the x column index
+	 * @param newYColumn the y column index
+	 */
+	void setColumns(size_t newXColumn, size_t newYColumn);
+
+	/**
+	 * @brief Sets the columns that should be used as the x and y coordinates
+	 *
+	 * @param xColumnName the x column name
+	 * @param yColumnName the y column name
+	 */
+	void setColumns(const string& xColumnName, const string& yColumnName);
+
+	/**
+	 * @brief Returns the number of rows
+	 *
+	 * @return the number of rows
+	 */
+	size_t getNumRows() const;
+
+	/**
+	 * @brief Returns the number of columns
+	 *
+	 * @return the number of columns
+	 */
+	size_t getNumColumns() const;
+
+	/**
+	 * @brief Returns the name of a column. The columns of .npy files are named after the file
+	 *
+	 * @param column the column index
+	 *
+	 * @return the column name
+	 */
+	const string& getColumnName(size_t column) const;
+
+	/**
+	 * @brief Returns the index of a column
+	 *
+	 * @param name the column name
+	 *
+	 * @return the column index. It will return -1 if there is no column with that name
+	 */
+	int getColumnIndex(const string& name) const;
+
+	/**
+	 * @brief Returns the first and last values of the x column. Only the pages of these two values are touched
+	 *
+	 * @return the x column limits. It will return {infinity, -infinity} if there are no rows
+	 */
+	array<float, 2> getXLim() const;
+
+protected:
+
+	/**
+	 * @brief Mapped file class
+	 */
+	struct MappedFile {
+		/**
+		 * @brief The mapped file content
+		 */
+		const uint8_t* data;
+
+		/**
+		 * @brief The file size in bytes
+		 */
+		size_t size;
+	};
+
+	/**
+	 * @brief Column class
+	 */
+	struct Column {
+		/**
+		 * @brief The column name
+		 */
+		string name;
+
+		/**
+		 * @brief Pointer to the first element of the column
+		 */
+		const uint8_t* data;
+
+		/**
+		 * @brief The distance in bytes between two consecutive elements
+		 */
+		size_t stride;
+
+		/**
+		 * @brief The element size in bytes (4 for float32 and 8 for float64)
+		 */
+		size_t elementSize;
+
+		/**
+		 * @brief The mapped file that contains the column
+		 */
+		shared_ptr<const MappedFile> file;
+	};
+
+	/**
+	 * @brief Maps a file in read only mode
+	 *
+	 * @param path the absolute path to the file
+	 * @param file the mapped file
+	 *
+	 * @return true if the file could be mapped
+	 */
+	static bool mapFile(const string& path, MappedFile& file);
+
+	/**
+	 * @brief Unmaps a file
+	 *
+	 * @param file the mapped file
+	 */
+	static void unmapFile(const MappedFile& file);
+
+	/**
+	 * @brief Obtains the columns of a mapped columnar file
+	 *
+	 * @param file the mapped file
+	 * @param fileColumns the vector where the file columns should be added
+	 * @param fileNumRows the number of rows in the file
+	 *
+	 * @return true if the file has a valid format
+	 */
+	static bool parseColumnarFile(const MappedFile& file, vector<Column>& fileColumns, size_t& fileNumRows);
+
+	/**
+	 * @brief Obtains the columns of a mapped .npy file
+	 *
+	 * @param file the mapped file
+	 * @param name the name to use for the file columns
+	 * @param fileColumns the vector where the file columns should be added
+	 * @param fileNumRows the number of rows in the file
+	 *
+	 * @return true if the file has a valid format
+	 */
+	static bool parseNpyFile(const MappedFile& file, const string& name, vector<Column>& fileColumns,
+			size_t& fileNumRows);
+
+	/**
+	 * @brief Returns one of the column values
+	 *
+	 * @param column the column
+	 * @param row the row index
+	 *
+	 * @return the column value
+	 */
+	static double getValue(const Column& column, size_t row);
+
+	/**
+	 * @brief Returns the index of the first row with an x value that is not smaller than a given value
+	 *
+	 * @param value the value to compare with
+	 *
+	 * @return the row index, or the number of rows if all the x values are smaller
+	 */
+	size_t lowerBoundX(double value) const;
+
+	/**
+	 * @brief Returns the index of the first row with an x value that is larger than a given value
+	 *
+	 * @param value the value to compare with
+	 *
+	 * @return the row index, or the number of rows if all the x values are smaller or equal
+	 */
+	size_t upperBoundX(double value) const;
+
+	/**
+	 * @brief The mapped files. Each file is unmapped when its last owner releases it
+	 */
+	vector<shared_ptr<const MappedFile>> files;
+
+	/**
+	 * @brief The columns of all the mapped files
+	 */
+	vector<Column> columns;
+
+	/**
+	 * @brief The number of rows
+	 */
+	size_t numRows;
+
+	/**
+	 * @brief The x column index
+	 */
+	size_t xColumn;
+
+	/**
+	 * @brief The y column index
+	 */
+	size_t yColumn;
+};
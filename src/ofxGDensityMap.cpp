@@ -0,0 +1,110 @@
+#include "ofxGDensityMap.h"
+#include "ofxGPointArray.h"
+#include "ofMain.h"
+
+ofxGDensityMap::ofxGDensityMap() :
+		nCols(0), nRows(0), maxCount(0) {
+	setColors( { ofColor(0, 0, 255), ofColor(0, 255, 255), ofColor(255, 255, 0), ofColor(255, 0, 0) });
+}
+
+void ofxGDensityMap::update(const ofxGPointArray& plotPoints, const array<float, 2>& dim) {
+	nCols = max(int(ceil(dim[0])), 1);
+	nRows = max(int(ceil(dim[1])), 1);
+	counts.assign(nCols * nRows, 0);
+
+	// Count the points in each pixel. The y coordinate is negative inside the plot box
+	auto countPoints = [&](ofxGPointArray::size_type first, ofxGPointArray::size_type last, vector<unsigned int>& grid) {
+		for (ofxGPointArray::size_type i = first; i < last; ++i) {
+			if (plotPoints.isInside(i)) {
+				int col = min(int(plotPoints.getX(i)), nCols - 1);
+				int row = min(max(int(dim[1] + plotPoints.getY(i)), 0), nRows - 1);
+				++grid[row * nCols + col];
+			}
+		}
+	};
+
+	// Divide the points between the threads. Each thread should have enough points to compensate the grid cost
+	ofxGPointArray::size_type nPoints = plotPoints.size();
+	ofxGPointArray::size_type minPointsPerThread = max(ofxGPointArray::size_type(65536), counts.size());
+	ofxGPointArray::size_type nThreads = min(ofxGPointArray::size_type(max(thread::hardware_concurrency(), 1u)),
+			nPoints / minPointsPerThread + 1);
+	ofxGPointArray::size_type pointsPerThread = nPoints / nThreads + 1;
+	vector<vector<unsigned int>> threadCounts(nThreads - 1, vector<unsigned int>(counts.size(), 0));
+	vector<thread> threads;
+
+	for (ofxGPointArray::size_type t = 1; t < nThreads; ++t) {
+		threads.emplace_back(countPoints, t * pointsPerThread, min((t + 1) * pointsPerThread, nPoints),
+				ref(threadCounts[t - 1]));
+	}
+
+	countPoints(0, min(pointsPerThread, nPoints), counts);
+
+	for (thread& t : threads) {
+		t.join();
+	}
+
+	for (const vector<unsigned int>& grid : threadCounts) {
+		for (vector<unsigned int>::size_type i = 0; i < counts.size(); ++i) {
+			counts[i] += grid[i];
+		}
+	}
+
+	maxCount = *max_element(counts.begin(), counts.end());
+	updateImage();
+}
+
+void ofxGDensityMap::draw() const {
+	if (image.isAllocated()) {
+		image.draw(0, -nRows);
+	}
+}
+
+void ofxGDensityMap::setColors(const vector<ofColor>& colors) {
+	if (colors.empty()) {
+		throw invalid_argument("The colormap should contain at least one color.");
+	}
+
+	int nColors = colors.size();
+
+	for (int i = 0; i < 256; ++i) {
+		float pos = (nColors - 1) * i / 255.0;
+		int index = min(int(pos), nColors - 2);
+
+		if (nColors == 1) {
+			lut[i] = colors[0];
+		} else {
+			lut[i] = colors[index].getLerped(colors[index + 1], pos - index);
+		}
+	}
+
+	if (!counts.empty()) {
+		updateImage();
+	}
+}
+
+unsigned int ofxGDensityMap::getMaxCount() const {
+	return maxCount;
+}
+
+void ofxGDensityMap::updateImage() {
+	ofPixels pixels;
+	pixels.allocate(nCols, nRows, OF_IMAGE_COLOR_ALPHA);
+	unsigned char* data = pixels.getData();
+
+	// Use a logarithmic scale, so the low density regions are still visible
+	float logMaxCount = log(max(maxCount, 2u));
+
+	for (vector<unsigned int>::size_type i = 0; i < counts.size(); ++i) {
+		if (counts[i] > 0) {
+			const ofColor& c = lut[int(255 * log(counts[i]) / logMaxCount)];
+			data[4 * i] = c.r;
+			data[4 * i + 1] = c.g;
+			data[4 * i + 2] = c.b;
+			data[4 * i + 3] = c.a;
+		} else {
+			data[4 * i + 3] = 0;
+		}
+	}
+
+	image.setFromPixels(pixels);
+}
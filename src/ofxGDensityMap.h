@@ -0,0 +1,92 @@
+#pragma once
+
+#include "ofxGPointArray.h"
+#include "ofMain.h"
+
+/**
+ * @brief Density map class
+ *
+ * An ofxGDensityMap counts the number of points that fall on each pixel of the plot box and represents the counts as an
+ * image, mapping them through a color lookup table. The cost of drawing the image depends on the plot box dimensions
+ * and not on the number of points.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGDensityMap {
+public:
+
+	/**
+	 * @brief Constructor
+	 */
+	ofxGDensityMap();
+
+	/**
+	 * @brief Counts the points inside the plot box and updates the density image
+	 *
+	 * The points are divided between several threads, each one filling its own count grid. The grids are added at the
+	 * end.
+	 *
+	 * @param plotPoints the points in the plot reference system. Only the points inside the plot box are counted
+	 * @param dim the plot box dimensions
+	 */
+	void update(const ofxGPointArray& plotPoints, const array<float, 2>& dim);
+
+	/**
+	 * @brief Draws the density image in the plot box
+	 */
+	void draw() const;
+
+	/**
+	 * @brief Sets the colors used to represent the point counts
+	 *
+	 * The lookup table is obtained interpolating the colors. The first color is used for pixels with one point and the
+	 * last color for the pixels with the largest count. Pixels without points are transparent.
+	 *
+	 * @param colors the colormap colors. It should contain at least one color
+	 */
+	void setColors(const vector<ofColor>& colors);
+
+	/**
+	 * @brief Returns the largest number of points in a pixel
+	 *
+	 * @return the largest number of points in a pixel
+	 */
+	unsigned int getMaxCount() const;
+
+protected:
+
+	/**
+	 * @brief Fills the image pixels using the current counts and color lookup table
+	 */
+	void updateImage();
+
+	/**
+	 * @brief The number of pixel columns
+	 */
+	int nCols;
+
+	/**
+	 * @brief The number of pixel rows
+	 */
+	int nRows;
+
+	/**
+	 * @brief The number of points in each pixel, ordered by rows starting from the top of the plot box
+	 */
+	vector<unsigned int> counts;
+
+	/**
+	 * @brief The largest number of points in a pixel
+	 */
+	unsigned int maxCount;
+
+	/**
+	 * @brief The color lookup table
+	 */
+	array<ofColor, 256> lut;
+
+	/**
+	 * @brief The density image
+	 */
+	ofImage image;
+};
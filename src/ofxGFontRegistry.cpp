@@ -0,0 +1,40 @@
+#include "ofxGFontRegistry.h"
+#include "ofMain.h"
+
+shared_ptr<ofTrueTypeFont> ofxGFontRegistry::getFont(const string& fontName, int fontSize, bool fontMakeContours) {
+	lock_guard<mutex> lock(getMutex());
+	map<ofxGFontKey, weak_ptr<ofTrueTypeFont>>& fonts = getFonts();
+	weak_ptr<ofTrueTypeFont>& entry = fonts[ofxGFontKey(fontName, fontSize, fontMakeContours)];
+	shared_ptr<ofTrueTypeFont> font = entry.lock();
+
+	if (!font) {
+		font = make_shared<ofTrueTypeFont>();
+		font->load(fontName, fontSize, true, true, fontMakeContours);
+		entry = font;
+
+		// Remove the entries of the fonts that have been released
+		for (auto it = fonts.begin(); it != fonts.end();) {
+			it = it->second.expired() ? fonts.erase(it) : next(it);
+		}
+	}
+
+	return font;
+}
+
+size_t ofxGFontRegistry::getNumFonts() {
+	lock_guard<mutex> lock(getMutex());
+	const map<ofxGFontKey, weak_ptr<ofTrueTypeFont>>& fonts = getFonts();
+	return count_if(fonts.begin(), fonts.end(), [](const pair<const ofxGFontKey, weak_ptr<ofTrueTypeFont>>& entry) {
+		return !entry.second.expired();
+	});
+}
+
+map<ofxGFontRegistry::ofxGFontKey, weak_ptr<ofTrueTypeFont>>& ofxGFontRegistry::getFonts() {
+	static map<ofxGFontKey, weak_ptr<ofTrueTypeFont>> fonts;
+	return fonts;
+}
+
+mutex& ofxGFontRegistry::getMutex() {
+	static mutex registryMutex;
+	return registryMutex;
+}
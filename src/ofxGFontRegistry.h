@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ * @brief Font registry class
+ *
+ * The ofxGFontRegistry shares the loaded trueType fonts between all the plot components. Fonts with the same name, size
+ * and contours option are only loaded once. A font is released when none of the components uses it anymore.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGFontRegistry {
+public:
+
+	/**
+	 * @brief Returns a font with the given properties, loading it only if it's not already in use
+	 *
+	 * @param fontName the font name
+	 * @param fontSize the font size
+	 * @param fontMakeContours true if the font contours should be calculated
+	 *
+	 * @return a shared pointer to the font
+	 */
+	static shared_ptr<ofTrueTypeFont> getFont(const string& fontName, int fontSize, bool fontMakeContours);
+
+	/**
+	 * @brief Returns the number of fonts that are currently in use
+	 *
+	 * @return the number of fonts in use
+	 */
+	static size_t getNumFonts();
+
+protected:
+
+	/**
+	 * @brief The font properties: name, size and contours option
+	 */
+	typedef tuple<string, int, bool> ofxGFontKey;
+
+	/**
+	 * @brief Returns the registered fonts. The registry doesn't keep the fonts alive
+	 *
+	 * @return the registered fonts
+	 */
+	static map<ofxGFontKey, weak_ptr<ofTrueTypeFont>>& getFonts();
+
+	/**
+	 * @brief Returns the mutex that protects the registered fonts
+	 *
+	 * @return the registry mutex
+	 */
+	static mutex& getMutex();
+};
@@ -1,9 +1,12 @@
 #include "ofxGHistogram.h"
 #include "ofxGConstants.h"
 #include "ofxGPoint.h"
+#include "ofxGPointArray.h"
+#include "ofxGFontRegistry.h"
 #include "ofMain.h"
 
-ofxGHistogram::ofxGHistogram(ofxGHistogramType _type, const array<float, 2>& _dim, const vector<ofxGPoint>& _plotPoints) :
+ofxGHistogram::ofxGHistogram(ofxGHistogramType _type, const array<float, 2>& _dim,
+		const ofxGPointArray& _plotPoints) :
 		type(_type), dim(_dim), plotPoints(_plotPoints) {
 	// General properties
 	visible = true;
@@ -22,7 +25,7 @@ ofxGHistogram::ofxGHistogram(ofxGHistogramType _type, const array<float, 2>& _di
 	fontColor = ofColor(0);
 	fontSize = 8;
 	fontMakeContours = false;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 
 	// Update the histogram containers
 	updateArrays();
@@ -41,24 +44,7 @@ void ofxGHistogram::updateArrays() {
 		vector<float> differences;
 
 		for (int i = 0; i < nPoints - 1; ++i) {
-			if (plotPoints[i].isValid() && plotPoints[i + 1].isValid()) {
-				float separation = separations[i % separations.size()];
-				float pointsSeparation;
-
-				if (type == GRAFICA_VERTICAL_HISTOGRAM) {
-					pointsSeparation = plotPoints[i + 1].getX() - plotPoints[i].getX();
-				} else {
-					pointsSeparation = plotPoints[i + 1].getY() - plotPoints[i].getY();
-				}
-
-				if (pointsSeparation > 0) {
-					differences.push_back((pointsSeparation - separation) / 2);
-				} else {
-					differences.push_back((pointsSeparation + separation) / 2);
-				}
-			} else {
-				differences.push_back(0);
-			}
+			differences.push_back(obtainDifference(i));
 		}
 
 		// Fill the leftSides and rightSides vectors
@@ -73,6 +59,140 @@ void ofxGHistogram::updateArrays() {
 		leftSides.push_back(differences.back());
 		rightSides.push_back(differences.back());
 	}
+
+	meshesNeedUpdate = true;
+}
+
+float ofxGHistogram::obtainDifference(int index) const {
+	if (!plotPoints.isValid(index) || !plotPoints.isValid(index + 1)) {
+		return 0;
+	}
+
+	float separation = separations[index % separations.size()];
+	float pointsSeparation;
+
+	if (type == GRAFICA_VERTICAL_HISTOGRAM) {
+		pointsSeparation = plotPoints.getX(index + 1) - plotPoints.getX(index);
+	} else {
+		pointsSeparation = plotPoints.getY(index + 1) - plotPoints.getY(index);
+	}
+
+	return (pointsSeparation > 0) ? (pointsSeparation - separation) / 2 : (pointsSeparation + separation) / 2;
+}
+
+void ofxGHistogram::updateLocalArrays(int first, int last) {
+	int nPoints = plotPoints.size();
+
+	if (nPoints <= 1) {
+		updateArrays();
+		return;
+	}
+
+	// Only the modified elements and their neighbors use their positions
+	for (int i = max(first - 1, 0); i <= min(last, nPoints - 1); ++i) {
+		if (i == 0) {
+			leftSides[i] = obtainDifference(0);
+			rightSides[i] = leftSides[i];
+		} else if (i == nPoints - 1) {
+			leftSides[i] = obtainDifference(nPoints - 2);
+			rightSides[i] = leftSides[i];
+		} else {
+			leftSides[i] = obtainDifference(i - 1);
+			rightSides[i] = obtainDifference(i);
+		}
+	}
+
+	meshesNeedUpdate = true;
+}
+
+bool ofxGHistogram::canUpdateLocally() const {
+	// Shifting the elements changes their separations, unless all separations are equal
+	return separations.size() == 1;
+}
+
+void ofxGHistogram::updateMeshes(float baseline) const {
+	// Map each line width to the outline batch that uses it
+	outlineMeshes.clear();
+	outlineMeshesWidths.clear();
+	vector<vector<ofVboMesh>::size_type> widthBatches;
+
+	for (float width : lineWidths) {
+		auto iter = find(outlineMeshesWidths.begin(), outlineMeshesWidths.end(), width);
+		widthBatches.push_back(iter - outlineMeshesWidths.begin());
+
+		if (iter == outlineMeshesWidths.end()) {
+			outlineMeshesWidths.push_back(width);
+		}
+	}
+
+	outlineMeshes.resize(outlineMeshesWidths.size());
+
+	for (ofVboMesh& outlineMesh : outlineMeshes) {
+		outlineMesh.setMode(OF_PRIMITIVE_LINES);
+	}
+
+	fillMesh.clear();
+	fillMesh.setMode(OF_PRIMITIVE_TRIANGLES);
+
+	for (ofxGPointArray::size_type i = 0; i < plotPoints.size(); ++i) {
+		if (plotPoints.isValid(i)) {
+			// Obtain the corners
+			float x1, x2, y1, y2;
+
+			if (type == GRAFICA_VERTICAL_HISTOGRAM) {
+				x1 = plotPoints.getX(i) - leftSides[i];
+				x2 = plotPoints.getX(i) + rightSides[i];
+				y1 = plotPoints.getY(i);
+				y2 = baseline;
+			} else {
+				x1 = baseline;
+				x2 = plotPoints.getX(i);
+				y1 = plotPoints.getY(i) - leftSides[i];
+				y2 = plotPoints.getY(i) + rightSides[i];
+			}
+
+			x1 = ofClamp(x1, 0, dim[0]);
+			x2 = ofClamp(x2, 0, dim[0]);
+			y1 = -ofClamp(-y1, 0, dim[1]);
+			y2 = -ofClamp(-y2, 0, dim[1]);
+
+			// Add the rectangle
+			bool cond1 = type == GRAFICA_VERTICAL_HISTOGRAM && x2 != x1 && !(y1 == y2 && (y1 == 0 || y1 == -dim[1]));
+			bool cond2 = type == GRAFICA_HORIZONTAL_HISTOGRAM && y2 != y1
+					&& !(x1 == x2 && (x1 == 0 || x1 == dim[0]));
+
+			if (cond1 || cond2) {
+				array<glm::vec3, 4> corners = {glm::vec3(x1, y1, 0), glm::vec3(x2, y1, 0), glm::vec3(x2, y2, 0),
+						glm::vec3(x1, y2, 0)};
+
+				// Add the two triangles that fill the rectangle
+				ofIndexType firstIndex = fillMesh.getNumVertices();
+				ofFloatColor bgColor = bgColors[i % bgColors.size()];
+
+				for (const glm::vec3& corner : corners) {
+					fillMesh.addVertex(corner);
+					fillMesh.addColor(bgColor);
+				}
+
+				fillMesh.addTriangle(firstIndex, firstIndex + 1, firstIndex + 2);
+				fillMesh.addTriangle(firstIndex, firstIndex + 2, firstIndex + 3);
+
+				// Add the four sides of the rectangle outline to the batch with the same line width
+				ofVboMesh& outlineMesh = outlineMeshes[widthBatches[i % widthBatches.size()]];
+				ofFloatColor lineColor = lineColors[i % lineColors.size()];
+
+				for (int j = 0; j < 4; ++j) {
+					outlineMesh.addVertex(corners[j]);
+					outlineMesh.addVertex(corners[(j + 1) % 4]);
+					outlineMesh.addColor(lineColor);
+					outlineMesh.addColor(lineColor);
+				}
+			}
+		}
+	}
+
+	meshesNeedUpdate = false;
+	meshesBaseline = baseline;
 }
 
 void ofxGHistogram::draw(const ofxGPoint& plotBasePoint) const {
@@ -84,48 +204,19 @@ void ofxGHistogram::draw(const ofxGPoint& plotBasePoint) const {
 			baseline = (type == GRAFICA_VERTICAL_HISTOGRAM) ? plotBasePoint.getY() : plotBasePoint.getX();
 		}
 
-		// Draw the rectangles
+		// Rebuild the meshes only if they are outdated
+		if (meshesNeedUpdate || baseline != meshesBaseline) {
+			updateMeshes(baseline);
+		}
+
+		// Draw the filled rectangles and then their outlines, one batch per line width
 		ofPushStyle();
-		ofSetRectMode(OF_RECTMODE_CORNER);
-
-		for (vector<ofxGPoint>::size_type i = 0; i < plotPoints.size(); ++i) {
-			if (plotPoints[i].isValid()) {
-				// Obtain the corners
-				float x1, x2, y1, y2;
-
-				if (type == GRAFICA_VERTICAL_HISTOGRAM) {
-					x1 = plotPoints[i].getX() - leftSides[i];
-					x2 = plotPoints[i].getX() + rightSides[i];
-					y1 = plotPoints[i].getY();
-					y2 = baseline;
-				} else {
-					x1 = baseline;
-					x2 = plotPoints[i].getX();
-					y1 = plotPoints[i].getY() - leftSides[i];
-					y2 = plotPoints[i].getY() + rightSides[i];
-				}
+		ofSetColor(255);
+		fillMesh.draw();
 
-				x1 = ofClamp(x1, 0, dim[0]);
-				x2 = ofClamp(x2, 0, dim[0]);
-				y1 = -ofClamp(-y1, 0, dim[1]);
-				y2 = -ofClamp(-y2, 0, dim[1]);
-
-				// Draw the rectangle
-				bool cond1 = type == GRAFICA_VERTICAL_HISTOGRAM && x2 != x1
-						&& !(y1 == y2 && (y1 == 0 || y1 == -dim[1]));
-				bool cond2 = type == GRAFICA_HORIZONTAL_HISTOGRAM && y2 != y1
-						&& !(x1 == x2 && (x1 == 0 || x1 == dim[0]));
-
-				if (cond1 || cond2) {
-					ofFill();
-					ofSetColor(bgColors[i % bgColors.size()]);
-					ofDrawRectangle(x1, y1, x2 - x1, y2 - y1);
-					ofNoFill();
-					ofSetLineWidth(lineWidths[i % lineWidths.size()]);
-					ofSetColor(lineColors[i % lineColors.size()]);
-					ofDrawRectangle(x1, y1, x2 - x1, y2 - y1);
-				}
-			}
+		for (vector<ofVboMesh>::size_type i = 0; i < outlineMeshes.size(); ++i) {
+			ofSetLineWidth(outlineMeshesWidths[i]);
+			outlineMeshes[i].draw();
 		}
 
 		ofPopStyle();
@@ -145,19 +236,19 @@ void ofxGHistogram::drawHistLabels() const {
 		if (rotateLabels) {
 			for (const ofxGPoint& p : plotPoints) {
 				if (p.isValid() && p.getX() >= 0 && p.getX() <= dim[0]) {
-					ofRectangle bounds = font.getStringBoundingBox(p.getLabel(), 0, 0);
+					ofRectangle bounds = font->getStringBoundingBox(p.getLabel(), 0, 0);
 					ofPushMatrix();
 					ofTranslate(p.getX() + fontSize / 2.0, labelsOffset + bounds.width);
 					ofRotateZDeg(-90);
-					font.drawString(p.getLabel(), 0, 0);
+					font->drawString(p.getLabel(), 0, 0);
 					ofPopMatrix();
 				}
 			}
 		} else {
 			for (const ofxGPoint& p : plotPoints) {
 				if (p.isValid() && p.getX() >= 0 && p.getX() <= dim[0]) {
-					ofRectangle bounds = font.getStringBoundingBox(p.getLabel(), 0, 0);
-					font.drawString(p.getLabel(), p.getX() - bounds.width / 2, labelsOffset + fontSize);
+					ofRectangle bounds = font->getStringBoundingBox(p.getLabel(), 0, 0);
+					font->drawString(p.getLabel(), p.getX() - bounds.width / 2, labelsOffset + fontSize);
 				}
 			}
 		}
@@ -165,19 +256,19 @@ void ofxGHistogram::drawHistLabels() const {
 		if (rotateLabels) {
 			for (const ofxGPoint& p : plotPoints) {
 				if (p.isValid() && -p.getY() >= 0 && -p.getY() <= dim[1]) {
-					ofRectangle bounds = font.getStringBoundingBox(p.getLabel(), 0, 0);
+					ofRectangle bounds = font->getStringBoundingBox(p.getLabel(), 0, 0);
 					ofPushMatrix();
 					ofTranslate(-labelsOffset, p.getY() + bounds.width / 2);
 					ofRotateZDeg(-90);
-					font.drawString(p.getLabel(), 0, 0);
+					font->drawString(p.getLabel(), 0, 0);
 					ofPopMatrix();
 				}
 			}
 		} else {
 			for (const ofxGPoint& p : plotPoints) {
 				if (p.isValid() && -p.getY() >= 0 && -p.getY() <= dim[1]) {
-					ofRectangle bounds = font.getStringBoundingBox(p.getLabel(), 0, 0);
-					font.drawString(p.getLabel(), -labelsOffset - bounds.width, p.getY() + fontSize / 2.0);
+					ofRectangle bounds = font->getStringBoundingBox(p.getLabel(), 0, 0);
+					font->drawString(p.getLabel(), -labelsOffset - bounds.width, p.getY() + fontSize / 2.0);
 				}
 			}
 		}
@@ -206,34 +297,79 @@ void ofxGHistogram::setDim(const array<float, 2>& newDim) {
 	setDim(newDim[0], newDim[1]);
 }
 
-void ofxGHistogram::setPlotPoints(const vector<ofxGPoint>& newPlotPoints) {
+void ofxGHistogram::setPlotPoints(const ofxGPointArray& newPlotPoints) {
 	plotPoints = newPlotPoints;
 	updateArrays();
 }
 
+void ofxGHistogram::setPlotPoints(const ofxGPointArray& newPlotPoints, vector<ofxGPoint>::size_type first,
+		vector<ofxGPoint>::size_type last) {
+	bool updateLocally = newPlotPoints.size() == plotPoints.size() && leftSides.size() == plotPoints.size();
+	plotPoints = newPlotPoints;
+
+	if (updateLocally) {
+		updateLocalArrays(first, last);
+	} else {
+		updateArrays();
+	}
+}
+
 void ofxGHistogram::setPlotPoint(vector<ofxGPoint>::size_type index, const ofxGPoint& newPlotPoint) {
-	plotPoints[index] = newPlotPoint;
-	updateArrays();
+	plotPoints.set(index, newPlotPoint.getX(), newPlotPoint.getY(), newPlotPoint.getLabel());
+	updateLocalArrays(index, index + 1);
 }
 
 void ofxGHistogram::addPlotPoint(const ofxGPoint& newPlotPoint) {
-	plotPoints.push_back(newPlotPoint);
-	updateArrays();
+	addPlotPoint(plotPoints.size(), newPlotPoint);
 }
 
-void ofxGHistogram::addPlotPoint(vector<ofxGPoint>::size_type index, ofxGPoint& newPlotPoint) {
-	plotPoints.insert(plotPoints.begin() + index, newPlotPoint);
-	updateArrays();
+void ofxGHistogram::addPlotPoint(vector<ofxGPoint>::size_type index, const ofxGPoint& newPlotPoint) {
+	bool isFull = plotPoints.getCapacity() > 0 && plotPoints.size() == plotPoints.getCapacity();
+	plotPoints.insert(index, newPlotPoint.getX(), newPlotPoint.getY(), newPlotPoint.getLabel());
+
+	if (canUpdateLocally()) {
+		// Adding a point at the beginning of a full array removes the last point, otherwise the first point is removed
+		if (isFull && index == 0) {
+			leftSides.pop_back();
+			rightSides.pop_back();
+		} else if (isFull) {
+			leftSides.pop_front();
+			rightSides.pop_front();
+			--index;
+		}
+
+		leftSides.insert(leftSides.begin() + index, 0);
+		rightSides.insert(rightSides.begin() + index, 0);
+		updateLocalArrays(index, index + 1);
+
+		// The element that replaces the removed one is now at the border
+		if (isFull) {
+			int border = (index == 0) ? plotPoints.size() - 1 : 0;
+			updateLocalArrays(border, border);
+		}
+	} else {
+		updateArrays();
+	}
 }
 
 void ofxGHistogram::addPlotPoints(const vector<ofxGPoint>& newPlotPoints) {
-	plotPoints.insert(plotPoints.end(), newPlotPoints.begin(), newPlotPoints.end());
+	for (const ofxGPoint& p : newPlotPoints) {
+		plotPoints.push_back(p);
+	}
+
 	updateArrays();
 }
 
 void ofxGHistogram::removePlotPoint(vector<ofxGPoint>::size_type index) {
-	plotPoints.erase(plotPoints.begin() + index);
-	updateArrays();
+	plotPoints.erase(index);
+
+	if (canUpdateLocally()) {
+		leftSides.erase(leftSides.begin() + index);
+		rightSides.erase(rightSides.begin() + index);
+		updateLocalArrays(index, index);
+	} else {
+		updateArrays();
+	}
 }
 
 void ofxGHistogram::setSeparations(const vector<float>& newSeparations) {
@@ -243,14 +379,17 @@ void ofxGHistogram::setSeparations(const vector<float>& newSeparations) {
 
 void ofxGHistogram::setBgColors(const vector<ofColor>& newBgColors) {
 	bgColors = newBgColors;
+	meshesNeedUpdate = true;
 }
 
 void ofxGHistogram::setLineColors(const vector<ofColor>& newLineColors) {
 	lineColors = newLineColors;
+	meshesNeedUpdate = true;
 }
 
 void ofxGHistogram::setLineWidths(const vector<float>& newLineWidths) {
 	lineWidths = newLineWidths;
+	meshesNeedUpdate = true;
 }
 
 void ofxGHistogram::setVisible(bool newVisible) {
@@ -271,7 +410,7 @@ void ofxGHistogram::setRotateLabels(bool newRotateLabels) {
 
 void ofxGHistogram::setFontName(const string& newFontName) {
 	fontName = newFontName;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGHistogram::setFontColor(const ofColor& newFontColor) {
@@ -284,7 +423,7 @@ void ofxGHistogram::setFontSize(int newFontSize) {
 	}
 
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGHistogram::setFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -295,10 +434,10 @@ void ofxGHistogram::setFontProperties(const string& newFontName, const ofColor&
 	fontName = newFontName;
 	fontColor = newFontColor;
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGHistogram::setFontMakeContours(bool newFontMakeContours) {
 	fontMakeContours = newFontMakeContours;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
@@ -2,6 +2,7 @@
 
 #include "ofxGConstants.h"
 #include "ofxGPoint.h"
+#include "ofxGPointArray.h"
 #include "ofMain.h"
 
 /**
@@ -20,7 +21,7 @@ public:
 	 * @param _plotPoints the points positions in the plot reference system
 	 */
 	ofxGHistogram(ofxGHistogramType _type = GRAFICA_VERTICAL_HISTOGRAM, const array<float, 2>& _dim = { 100, 100 },
-			const vector<ofxGPoint>& _plotPoints = { });
+			const ofxGPointArray& _plotPoints = { });
 
 	/**
 	 * @brief Draws the histogram
@@ -57,7 +58,17 @@ public:
 	 *
 	 * @param newPlotPoints the new point positions in the plot reference system
 	 */
-	void setPlotPoints(const vector<ofxGPoint>& newPlotPoints);
+	void setPlotPoints(const ofxGPointArray& newPlotPoints);
+
+	/**
+	 * @brief Sets the histogram plot points after a change in a range of them. The number of points should not change
+	 *
+	 * @param newPlotPoints the new point positions in the plot reference system
+	 * @param first the position of the first modified point
+	 * @param last the position after the last modified point
+	 */
+	void setPlotPoints(const ofxGPointArray& newPlotPoints, vector<ofxGPoint>::size_type first,
+			vector<ofxGPoint>::size_type last);
 
 	/**
 	 * @brief Sets one of the histogram plot points
@@ -80,7 +91,7 @@ public:
 	 * @param index the position to add the point
 	 * @param newPlotPoint the new point position in the plot reference system
 	 */
-	void addPlotPoint(vector<ofxGPoint>::size_type index, ofxGPoint& newPlotPoint);
+	void addPlotPoint(vector<ofxGPoint>::size_type index, const ofxGPoint& newPlotPoint);
 
 	/**
 	 * @brief Adds new plot points to the histogram
@@ -196,6 +207,38 @@ protected:
 	 */
 	void updateArrays();
 
+	/**
+	 * @brief Returns the half distance between two consecutive histogram elements, minus their half separation
+	 *
+	 * @param index the position of the first element
+	 *
+	 * @return the half distance between the elements, or zero if one of them is invalid
+	 */
+	float obtainDifference(int index) const;
+
+	/**
+	 * @brief Updates the leftSides and rightSides arrays after a change in a range of the plot points. Only the
+	 * modified elements and their neighbors are recalculated
+	 *
+	 * @param first the position of the first modified element
+	 * @param last the position after the last modified element
+	 */
+	void updateLocalArrays(int first, int last);
+
+	/**
+	 * @brief Checks if a point can be added or removed without recalculating all the leftSides and rightSides arrays
+	 *
+	 * @return true if the point can be added or removed with a local update
+	 */
+	bool canUpdateLocally() const;
+
+	/**
+	 * @brief Rebuilds the meshes with the filled rectangles and their outlines
+	 *
+	 * @param baseline the histogram baseline in the plot reference system
+	 */
+	void updateMeshes(float baseline) const;
+
 	/**
 	 * @brief Draws the histogram labels
 	 */
@@ -214,7 +257,7 @@ protected:
 	/**
 	 * @brief The points positions in the plot reference system
 	 */
-	vector<ofxGPoint> plotPoints;
+	ofxGPointArray plotPoints;
 
 	/**
 	 * @brief Defines if the histogram should be visible or not
@@ -242,14 +285,41 @@ protected:
 	vector<float> lineWidths;
 
 	/**
-	 * @brief The left side sizes of the histogram elements
+	 * @brief The left side sizes of the histogram elements. It's a deque, so the elements removed from the front of a
+	 * full plot points array can be dropped without shifting the rest
 	 */
-	vector<float> leftSides;
+	deque<float> leftSides;
 
 	/**
 	 * @brief The right side sizes of the histogram elements
 	 */
-	vector<float> rightSides;
+	deque<float> rightSides;
+
+	/**
+	 * @brief The mesh with the filled rectangles of the histogram elements. It's stored in the GPU, so it's only
+	 * uploaded after a rebuild
+	 */
+	mutable ofVboMesh fillMesh;
+
+	/**
+	 * @brief The meshes with the rectangle outlines, one for each different line width
+	 */
+	mutable vector<ofVboMesh> outlineMeshes;
+
+	/**
+	 * @brief The line widths used to draw each of the outline meshes
+	 */
+	mutable vector<float> outlineMeshesWidths;
+
+	/**
+	 * @brief Defines if the histogram meshes should be rebuilt before drawing them
+	 */
+	mutable bool meshesNeedUpdate;
+
+	/**
+	 * @brief The baseline used to build the histogram meshes
+	 */
+	mutable float meshesBaseline;
 
 	/**
 	 * @brief The labels offset
@@ -287,7 +357,7 @@ protected:
 	bool fontMakeContours;
 
 	/**
-	 * @brief The trueType font
+	 * @brief The trueType font. It is shared with the other plot components that use the same font properties
 	 */
-	ofTrueTypeFont font;
+	shared_ptr<ofTrueTypeFont> font;
 };
@@ -0,0 +1,182 @@
+#include "ofxGHistogramBinner.h"
+#include "ofxGPoint.h"
+#include "ofxGLayer.h"
+#include "ofMain.h"
+
+ofxGHistogramBinner::ofxGHistogramBinner(int _nBins, const array<float, 2>& _lim) :
+		normalized(false) {
+	setBins(_nBins, _lim);
+}
+
+void ofxGHistogramBinner::countSamples(const float* samples, size_t nSamples, vector<uint64_t>& binCounts) const {
+	// Process the samples in blocks, so the bin indices fit in the cache
+	const size_t blockSize = 1024;
+	array<int, blockSize> indices;
+
+	for (size_t first = 0; first < nSamples; first += blockSize) {
+		size_t n = std::min(blockSize, nSamples - first);
+		const float* block = samples + first;
+
+		// Calculate the bin indices. Samples outside the range (and NaNs) go to the extra bin
+		for (size_t i = 0; i < n; ++i) {
+			float sample = block[i];
+			bool inside = sample >= lim[0] && sample <= lim[1];
+			int index = int(((inside ? sample : lim[0]) - lim[0]) * invBinWidth);
+			indices[i] = inside ? std::min(index, nBins - 1) : nBins;
+		}
+
+		// Increment the counts
+		for (size_t i = 0; i < n; ++i) {
+			++binCounts[indices[i]];
+		}
+	}
+}
+
+void ofxGHistogramBinner::addSample(float sample) {
+	if (sample >= lim[0] && sample <= lim[1]) {
+		int bin = std::min(int((sample - lim[0]) * invBinWidth), nBins - 1);
+		++counts[bin];
+		++totalCount;
+
+		if (normalized) {
+			markAllChanged();
+		} else {
+			markChanged(bin);
+		}
+	}
+}
+
+void ofxGHistogramBinner::addSamples(const vector<float>& samples) {
+	addSamples(samples.data(), samples.size());
+}
+
+void ofxGHistogramBinner::addSamples(const float* samples, size_t nSamples) {
+	// Divide the samples between the threads. Each thread should have enough samples to compensate the counts cost
+	size_t minSamplesPerThread = std::max(size_t(65536), size_t(nBins));
+	size_t nThreads = std::min(size_t(std::max(thread::hardware_concurrency(), 1u)),
+			nSamples / minSamplesPerThread + 1);
+	size_t samplesPerThread = nSamples / nThreads + 1;
+	vector<vector<uint64_t>> threadCounts(nThreads, vector<uint64_t>(nBins + 1, 0));
+	vector<thread> threads;
+
+	for (size_t t = 1; t < nThreads; ++t) {
+		size_t first = std::min(t * samplesPerThread, nSamples);
+		size_t last = std::min((t + 1) * samplesPerThread, nSamples);
+		threads.emplace_back(&ofxGHistogramBinner::countSamples, this, samples + first, last - first,
+				ref(threadCounts[t]));
+	}
+
+	countSamples(samples, std::min(samplesPerThread, nSamples), threadCounts[0]);
+
+	for (thread& t : threads) {
+		t.join();
+	}
+
+	// Add the new counts and keep track of the bins that changed
+	uint64_t previousTotalCount = totalCount;
+
+	for (int bin = 0; bin < nBins; ++bin) {
+		uint64_t newCounts = 0;
+
+		for (const vector<uint64_t>& binCounts : threadCounts) {
+			newCounts += binCounts[bin];
+		}
+
+		if (newCounts > 0) {
+			counts[bin] += newCounts;
+			totalCount += newCounts;
+			markChanged(bin);
+		}
+	}
+
+	if (normalized && totalCount != previousTotalCount) {
+		markAllChanged();
+	}
+}
+
+void ofxGHistogramBinner::clear() {
+	fill(counts.begin(), counts.end(), 0);
+	totalCount = 0;
+	markAllChanged();
+}
+
+void ofxGHistogramBinner::updateLayer(ofxGLayer& layer) {
+	if (layer.getPointsRef().size() == ofxGPointArray::size_type(nBins)) {
+		float binWidth = 1 / invBinWidth;
+
+		for (int bin : changedBins) {
+			layer.setPoint(bin, lim[0] + (bin + 0.5) * binWidth, getBarValue(bin));
+			binChanged[bin] = false;
+		}
+	} else {
+		layer.setPoints(getPoints());
+		fill(binChanged.begin(), binChanged.end(), false);
+	}
+
+	changedBins.clear();
+}
+
+vector<ofxGPoint> ofxGHistogramBinner::getPoints() const {
+	vector<ofxGPoint> points;
+	float binWidth = 1 / invBinWidth;
+
+	for (int bin = 0; bin < nBins; ++bin) {
+		points.emplace_back(lim[0] + (bin + 0.5) * binWidth, getBarValue(bin));
+	}
+
+	return points;
+}
+
+float ofxGHistogramBinner::getBarValue(int bin) const {
+	if (normalized) {
+		return (totalCount > 0) ? double(counts[bin]) / totalCount : 0;
+	}
+
+	return counts[bin];
+}
+
+void ofxGHistogramBinner::markChanged(int bin) {
+	if (!binChanged[bin]) {
+		binChanged[bin] = true;
+		changedBins.push_back(bin);
+	}
+}
+
+void ofxGHistogramBinner::markAllChanged() {
+	for (int bin = 0; bin < nBins; ++bin) {
+		markChanged(bin);
+	}
+}
+
+void ofxGHistogramBinner::setBins(int newNBins, const array<float, 2>& newLim) {
+	// Check that the new bins make sense
+	if (newNBins <= 0) {
+		throw invalid_argument("The number of bins should be larger than zero.");
+	} else if (newLim[1] <= newLim[0]) {
+		throw invalid_argument("The bins upper limit should be larger than the lower limit.");
+	}
+
+	nBins = newNBins;
+	lim = newLim;
+	invBinWidth = nBins / (lim[1] - lim[0]);
+	counts.assign(nBins, 0);
+	totalCount = 0;
+	binChanged.assign(nBins, false);
+	changedBins.clear();
+	markAllChanged();
+}
+
+void ofxGHistogramBinner::setNormalized(bool newNormalized) {
+	if (newNormalized != normalized) {
+		normalized = newNormalized;
+		markAllChanged();
+	}
+}
+
+const vector<uint64_t>& ofxGHistogramBinner::getCounts() const {
+	return counts;
+}
+
+uint64_t ofxGHistogramBinner::getTotalCount() const {
+	return totalCount;
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "ofxGPoint.h"
+#include "ofxGLayer.h"
+#include "ofMain.h"
+
+/**
+ * @brief Histogram binner class
+ *
+ * An ofxGHistogramBinner counts raw samples in a set of equally spaced bins and keeps the histogram bars of a layer
+ * up to date. New samples are added to the existing counts, and only the bars whose count changed are updated in the
+ * layer, so a histogram over a continuous stream of samples never rebuilds its whole point set.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGHistogramBinner {
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param _nBins the number of bins
+	 * @param _lim the lower edge of the first bin and the upper edge of the last bin
+	 */
+	ofxGHistogramBinner(int _nBins = 10, const array<float, 2>& _lim = { 0, 1 });
+
+	/**
+	 * @brief Adds one sample to the bin counts. Samples outside the bins range are ignored
+	 *
+	 * @param sample the sample to add
+	 */
+	void addSample(float sample);
+
+	/**
+	 * @brief Adds several samples to the bin counts. Samples outside the bins range are ignored
+	 *
+	 * Large sets of samples are divided between several threads, each one filling its own bin counts. The counts are
+	 * added at the end.
+	 *
+	 * @param samples the samples to add
+	 */
+	void addSamples(const vector<float>& samples);
+
+	/**
+	 * @brief Adds several samples to the bin counts. Samples outside the bins range are ignored
+	 *
+	 * @param samples pointer to the first sample
+	 * @param nSamples the number of samples
+	 */
+	void addSamples(const float* samples, size_t nSamples);
+
+	/**
+	 * @brief Removes all the samples from the bin counts
+	 */
+	void clear();
+
+	/**
+	 * @brief Updates the histogram bars of a layer
+	 *
+	 * If the layer has one point per bin, only the bars whose value changed since the last update are modified and
+	 * their labels are kept. Otherwise the layer points are replaced with the bin points. The plot limits are not
+	 * recalculated.
+	 *
+	 * @param layer the layer to update
+	 */
+	void updateLayer(ofxGLayer& layer);
+
+	/**
+	 * @brief Returns the histogram bars as a vector of points, one per bin
+	 *
+	 * @return the bin centers and their counts, or their relative frequencies if the bins are normalized
+	 */
+	vector<ofxGPoint> getPoints() const;
+
+	/**
+	 * @brief Sets the bins. The current counts are removed
+	 *
+	 * @param newNBins the new number of bins
+	 * @param newLim the new lower edge of the first bin and upper edge of the last bin
+	 */
+	void setBins(int newNBins, const array<float, 2>& newLim);
+
+	/**
+	 * @brief Sets if the bar values should be normalized by the number of counted samples
+	 *
+	 * Note that all the bars change when a new sample is counted in a normalized histogram.
+	 *
+	 * @param newNormalized true if the bar values should be normalized
+	 */
+	void setNormalized(bool newNormalized);
+
+	/**
+	 * @brief Returns the number of samples in each bin
+	 *
+	 * @return the number of samples in each bin
+	 */
+	const vector<uint64_t>& getCounts() const;
+
+	/**
+	 * @brief Returns the number of samples that fell inside the bins range
+	 *
+	 * @return the number of samples that fell inside the bins range
+	 */
+	uint64_t getTotalCount() const;
+
+protected:
+
+	/**
+	 * @brief Counts a range of samples
+	 *
+	 * The bin indices are calculated in blocks without branches, so the compiler can vectorize the loop, and then the
+	 * counts are incremented. The samples outside the bins range go to an extra bin at the end of the counts.
+	 *
+	 * @param samples pointer to the first sample
+	 * @param nSamples the number of samples
+	 * @param binCounts the bin counts to increment. It should have nBins + 1 elements
+	 */
+	void countSamples(const float* samples, size_t nSamples, vector<uint64_t>& binCounts) const;
+
+	/**
+	 * @brief Returns the value of a bar
+	 *
+	 * @param bin the bin index
+	 * @return the value of the bar
+	 */
+	float getBarValue(int bin) const;
+
+	/**
+	 * @brief Marks a bin as changed since the last layer update
+	 *
+	 * @param bin the bin index
+	 */
+	void markChanged(int bin);
+
+	/**
+	 * @brief Marks all the bins as changed since the last layer update
+	 */
+	void markAllChanged();
+
+	/**
+	 * @brief The number of bins
+	 */
+	int nBins;
+
+	/**
+	 * @brief The lower edge of the first bin and the upper edge of the last bin
+	 */
+	array<float, 2> lim;
+
+	/**
+	 * @brief The inverse of the bin width
+	 */
+	float invBinWidth;
+
+	/**
+	 * @brief Defines if the bar values are normalized by the number of counted samples
+	 */
+	bool normalized;
+
+	/**
+	 * @brief The number of samples in each bin
+	 */
+	vector<uint64_t> counts;
+
+	/**
+	 * @brief The number of samples that fell inside the bins range
+	 */
+	uint64_t totalCount;
+
+	/**
+	 * @brief Defines if a bin changed since the last layer update
+	 */
+	vector<bool> binChanged;
+
+	/**
+	 * @brief The bins that changed since the last layer update
+	 */
+	vector<int> changedBins;
+};
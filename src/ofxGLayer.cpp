@@ -1,7 +1,14 @@
 #include "ofxGLayer.h"
 #include "ofxGConstants.h"
 #include "ofxGPoint.h"
+#include "ofxGPointArray.h"
+#include "ofxGPointSpan.h"
+#include "ofxGPointGrid.h"
+#include "ofxGLineDecimator.h"
+#include "ofxGLineClipper.h"
+#include "ofxGPolygonClipper.h"
 #include "ofxGHistogram.h"
+#include "ofxGFontRegistry.h"
 #include "ofMain.h"
 
 ofxGLayer::ofxGLayer(const string& _id, const array<float, 2>& _dim, const array<float, 2>& _xLim,
@@ -24,6 +31,10 @@ ofxGLayer::ofxGLayer(const string& _id, const array<float, 2>& _dim, const array
 	histBasePoint = ofxGPoint(0, 0);
 	histIsActive = false;
 
+	// Batch updates properties
+	updateDepth = 0;
+	plotPointsNeedUpdate = false;
+
 	// Labels properties
 	labelBgColor = ofColor(255, 200);
 	labelSeparation = {7, 7};
@@ -33,7 +44,28 @@ ofxGLayer::ofxGLayer(const string& _id, const array<float, 2>& _dim, const array
 	fontColor = ofColor(0);
 	fontSize = 8;
 	fontMakeContours = false;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
+
+	// Meshes properties
+	pointsMeshNeedsUpdate = true;
+	pointsMeshCircleResolution = 0;
+	pointsMeshHasColors = false;
+	linesMeshNeedsUpdate = true;
+	meshRebuildCount = 0;
+	pointsGridNeedsUpdate = true;
+	linesDecimation = false;
+
+	// Downsampling properties
+	downsamplingPoints = 0;
+	sampledIndicesNeedUpdate = true;
+
+	// Density map properties
+	densityMapNeedsUpdate = true;
+
+	// Contour mesh properties
+	contourMeshNeedsUpdate = true;
+	contourMeshType = GRAFICA_HORIZONTAL_CONTOUR;
+	contourMeshReferenceValue = 0;
 }
 
 bool ofxGLayer::isId(const string& someId) const {
@@ -109,380 +141,223 @@ vector<ofxGPoint> ofxGLayer::valueToPlot(const vector<ofxGPoint>& pts) const {
 }
 
 void ofxGLayer::updatePlotPoints() {
-	plotPoints.clear();
-
-	if (xLogScale && yLogScale) {
-		float xScalingFactor = dim[0] / log10(xLim[1] / xLim[0]);
-		float yScalingFactor = -dim[1] / log10(yLim[1] / yLim[0]);
-
-		for (const ofxGPoint& p : points) {
-			float xPlot = log10(p.getX() / xLim[0]) * xScalingFactor;
-			float yPlot = log10(p.getY() / yLim[0]) * yScalingFactor;
-			plotPoints.emplace_back(xPlot, yPlot, p.getLabel());
-		}
-	} else if (xLogScale) {
-		float xScalingFactor = dim[0] / log10(xLim[1] / xLim[0]);
-		float yScalingFactor = -dim[1] / (yLim[1] - yLim[0]);
-
-		for (const ofxGPoint& p : points) {
-			float xPlot = log10(p.getX() / xLim[0]) * xScalingFactor;
-			float yPlot = (p.getY() - yLim[0]) * yScalingFactor;
-			plotPoints.emplace_back(xPlot, yPlot, p.getLabel());
-		}
-	} else if (yLogScale) {
-		float xScalingFactor = dim[0] / (xLim[1] - xLim[0]);
-		float yScalingFactor = -dim[1] / log10(yLim[1] / yLim[0]);
-
-		for (const ofxGPoint& p : points) {
-			float xPlot = (p.getX() - xLim[0]) * xScalingFactor;
-			float yPlot = log10(p.getY() / yLim[0]) * yScalingFactor;
-			plotPoints.emplace_back(xPlot, yPlot, p.getLabel());
-		}
-	} else {
-		float xScalingFactor = dim[0] / (xLim[1] - xLim[0]);
-		float yScalingFactor = -dim[1] / (yLim[1] - yLim[0]);
+	array<float, 2> offsets;
+	array<float, 2> factors;
+	calculatePlotTransformation(offsets, factors);
+	plotPoints.setTransformed(points, offsets, factors, {xLogScale, yLogScale}, dim);
+	invalidateCaches();
+}
 
-		for (const ofxGPoint& p : points) {
-			float xPlot = (p.getX() - xLim[0]) * xScalingFactor;
-			float yPlot = (p.getY() - yLim[0]) * yScalingFactor;
-			plotPoints.emplace_back(xPlot, yPlot, p.getLabel());
-		}
-	}
+void ofxGLayer::updatePlotPoints(vector<ofxGPoint>::size_type first, vector<ofxGPoint>::size_type last) {
+	array<float, 2> offsets;
+	array<float, 2> factors;
+	calculatePlotTransformation(offsets, factors);
+	plotPoints.setTransformed(points, first, last, offsets, factors, {xLogScale, yLogScale}, dim);
+	invalidateCaches();
 }
 
-float ofxGLayer::xPlotToValue(float xPlot) const {
+void ofxGLayer::calculatePlotTransformation(array<float, 2>& offsets, array<float, 2>& factors) const {
+	// The plot coordinates are (value - offset) * factor, where value and offset are in log10 for logarithmic scales
 	if (xLogScale) {
-		return pow(10, log10(xLim[0]) + log10(xLim[1] / xLim[0]) * xPlot / dim[0]);
+		offsets[0] = log10(xLim[0]);
+		factors[0] = dim[0] / log10(xLim[1] / xLim[0]);
 	} else {
-		return xLim[0] + (xLim[1] - xLim[0]) * xPlot / dim[0];
+		offsets[0] = xLim[0];
+		factors[0] = dim[0] / (xLim[1] - xLim[0]);
 	}
-}
 
-float ofxGLayer::yPlotToValue(float yPlot) const {
 	if (yLogScale) {
-		return pow(10, log10(yLim[0]) - log10(yLim[1] / yLim[0]) * yPlot / dim[1]);
+		offsets[1] = log10(yLim[0]);
+		factors[1] = -dim[1] / log10(yLim[1] / yLim[0]);
 	} else {
-		return yLim[0] - (yLim[1] - yLim[0]) * yPlot / dim[1];
+		offsets[1] = yLim[0];
+		factors[1] = -dim[1] / (yLim[1] - yLim[0]);
 	}
 }
 
-array<float, 2> ofxGLayer::plotToValue(float xPlot, float yPlot) const {
-	return {xPlotToValue(xPlot), yPlotToValue(yPlot)};
-}
+void ofxGLayer::detachPoints() {
+	if (!points.isExternal()) {
+		return;
+	}
 
-bool ofxGLayer::isInside(float xPlot, float yPlot) const {
-	return (xPlot >= 0) && (xPlot <= dim[0]) && (-yPlot >= 0) && (-yPlot <= dim[1]);
-}
+	points.detach();
 
-bool ofxGLayer::isInside(const ofxGPoint& plotPoint) const {
-	return plotPoint.isValid() ? isInside(plotPoint.getX(), plotPoint.getY()) : false;
-}
+	// The copy drops the first points if the layer has a fixed capacity. The plot points are a view of the same span,
+	// so they should be copied too before the caller releases it
+	if (points.size() == plotPoints.size()) {
+		plotPoints.detach();
+		plotPoints.setCapacity(points.getCapacity());
 
-vector<bool> ofxGLayer::isInside(const vector<ofxGPoint>& plotPts) const {
-	vector<bool> pointsInside;
+		if (histIsActive) {
+			hist.setPlotPoints(plotPoints);
+		}
 
-	for (const ofxGPoint& p : plotPts) {
-		pointsInside.push_back(isInside(p));
+		return;
 	}
 
-	return pointsInside;
-}
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
 
-void ofxGLayer::updateInsideList() {
-	inside.clear();
+	updatePlotPoints();
 
-	for (const ofxGPoint& p : plotPoints) {
-		inside.push_back(isInside(p));
+	if (histIsActive) {
+		hist.setPlotPoints(plotPoints);
 	}
 }
 
-vector<ofxGPoint>::size_type ofxGLayer::getPointIndexAtPlotPos(float xPlot, float yPlot) const {
-	vector<ofxGPoint>::size_type pointIndex = plotPoints.size();
-
-	if (isInside(xPlot, yPlot)) {
-		float minDistSq = 1000000;
-
-		for (vector<ofxGPoint>::size_type i = 0; i < plotPoints.size(); ++i) {
-			if (inside[i]) {
-				float distSq = pow(plotPoints[i].getX() - xPlot, 2) + pow(plotPoints[i].getY() - yPlot, 2);
+void ofxGLayer::invalidateCaches() {
+	pointsMeshNeedsUpdate = true;
+	linesMeshNeedsUpdate = true;
+	pointsGridNeedsUpdate = true;
+	sampledIndicesNeedUpdate = true;
+	densityMapNeedsUpdate = true;
+	contourMeshNeedsUpdate = true;
+}
 
-				if (distSq < max(static_cast<float>(pow(pointSizes[i % pointSizes.size()], 2)), 25.0f)) {
-					if (distSq < minDistSq) {
-						minDistSq = distSq;
-						pointIndex = i;
-					}
-				}
-			}
-		}
+const vector<ofxGPointArray::size_type>* ofxGLayer::getSampledIndices() const {
+	if (downsamplingPoints == 0) {
+		return nullptr;
 	}
 
-	return pointIndex;
-}
-
-const ofxGPoint* ofxGLayer::getPointAtPlotPos(float xPlot, float yPlot) const {
-	vector<ofxGPoint>::size_type pointIndex = getPointIndexAtPlotPos(xPlot, yPlot);
+	if (sampledIndicesNeedUpdate) {
+		updateSampledIndices();
+	}
 
-	return (pointIndex < points.size()) ? &points[pointIndex] : nullptr;
+	return &sampledIndices;
 }
 
-int ofxGLayer::obtainBoxIntersections(const ofxGPoint& plotPoint1, const ofxGPoint& plotPoint2) {
-	int nCuts = 0;
-
-	if (plotPoint1.isValid() && plotPoint2.isValid()) {
-		float x1 = plotPoint1.getX();
-		float y1 = plotPoint1.getY();
-		float x2 = plotPoint2.getX();
-		float y2 = plotPoint2.getY();
-		bool inside1 = isInside(x1, y1);
-		bool inside2 = isInside(x2, y2);
-
-		// Check if the line between the two points could cut the box borders
-		bool dontCut = (inside1 && inside2) || (x1 < 0 && x2 < 0) || (x1 > dim[0] && x2 > dim[0])
-				|| (-y1 < 0 && -y2 < 0) || (-y1 > dim[1] && -y2 > dim[1]);
-
-		if (!dontCut) {
-			// Obtain the axis cuts of the line that cross the two points
-			float deltaX = x2 - x1;
-			float deltaY = y2 - y1;
-
-			if (deltaX == 0) {
-				nCuts = 2;
-				cuts[0][0] = x1;
-				cuts[0][1] = 0;
-				cuts[1][0] = x1;
-				cuts[1][1] = -dim[1];
-			} else if (deltaY == 0) {
-				nCuts = 2;
-				cuts[0][0] = 0;
-				cuts[0][1] = y1;
-				cuts[1][0] = dim[0];
-				cuts[1][1] = y1;
-			} else {
-				// Obtain the straight line (y = yCut + slope*x) that crosses the two points
-				float slope = deltaY / deltaX;
-				float yCut = y1 - slope * x1;
-
-				// Calculate the axis cuts of that line
-				nCuts = 4;
-				cuts[0][0] = -yCut / slope;
-				cuts[0][1] = 0;
-				cuts[1][0] = (-dim[1] - yCut) / slope;
-				cuts[1][1] = -dim[1];
-				cuts[2][0] = 0;
-				cuts[2][1] = yCut;
-				cuts[3][0] = dim[0];
-				cuts[3][1] = yCut + slope * dim[0];
-			}
+void ofxGLayer::updateSampledIndices() const {
+	// If the points are sorted in x, only sample the visible points and their closest neighbours
+	ofxGPointArray::size_type first = 0;
+	ofxGPointArray::size_type last = points.size();
 
-			// Select only the cuts that fall inside the box and are located between the two points
-			nCuts = getValidCuts(cuts, nCuts, plotPoint1, plotPoint2);
-
-			// Make sure we have the correct number of cuts
-			if (inside1 || inside2) {
-				// One of the points is inside. We should have one cut only
-				if (nCuts != 1) {
-					const ofxGPoint& pointInside = (inside1) ? plotPoint1 : plotPoint2;
-
-					// If too many cuts
-					if (nCuts > 1) {
-						nCuts = removeDuplicatedCuts(cuts, nCuts, 0);
-
-						if (nCuts > 1) {
-							nCuts = removePointFromCuts(cuts, nCuts, pointInside, 0);
-
-							// In case of rounding number errors
-							if (nCuts > 1) {
-								nCuts = removeDuplicatedCuts(cuts, nCuts, 0.001f);
-
-								if (nCuts > 1) {
-									nCuts = removePointFromCuts(cuts, nCuts, pointInside, 0.001f);
-								}
-							}
-						}
-					}
-
-					// If the cut is missing, then it must be equal to the point inside
-					if (nCuts == 0) {
-						nCuts = 1;
-						cuts[0][0] = pointInside.getX();
-						cuts[0][1] = pointInside.getY();
-					}
-				}
-			} else {
-				// Both points are outside. We should have either two cuts or none
-				if (nCuts > 2) {
-					nCuts = removeDuplicatedCuts(cuts, nCuts, 0);
-
-					// In case of rounding number errors
-					if (nCuts > 2) {
-						nCuts = removeDuplicatedCuts(cuts, nCuts, 0.001f);
-					}
-				}
-
-				// If we have two cuts, order them (the closest to the first point goes first)
-				if (nCuts == 2) {
-					if ((pow(cuts[0][0] - x1, 2) + pow(cuts[0][1] - y1, 2))
-							> (pow(cuts[1][0] - x1, 2) + pow(cuts[1][1] - y1, 2))) {
-						cuts[2][0] = cuts[0][0];
-						cuts[2][1] = cuts[0][1];
-						cuts[0][0] = cuts[1][0];
-						cuts[0][1] = cuts[1][1];
-						cuts[1][0] = cuts[2][0];
-						cuts[1][1] = cuts[2][1];
-					}
-				}
+	if (points.isSortedByX()) {
+		first = points.lowerBoundX(min(xLim[0], xLim[1]));
+		last = points.upperBoundX(max(xLim[0], xLim[1]));
+		first = (first > 0) ? first - 1 : first;
+		last = (last < points.size()) ? last + 1 : last;
+	}
 
-				// If one cut is missing, add the same one twice
-				if (nCuts == 1) {
-					nCuts = 2;
-					cuts[1][0] = cuts[0][0];
-					cuts[1][1] = cuts[0][1];
-				}
-			}
+	// Get the valid points positions
+	vector<ofxGPointArray::size_type> validIndices;
 
-			// Some sanity checks
-			if ((inside1 || inside2) && nCuts != 1) {
-				ofLogError("There should be one cut!!!");
-			} else if (!inside1 && !inside2 && nCuts != 0 && nCuts != 2) {
-				ofLogError("There should be either 0 or 2 cuts!!! " + to_string(nCuts) + " were found");
-			}
+	for (ofxGPointArray::size_type i = first; i < last; ++i) {
+		if (plotPoints.isValid(i)) {
+			validIndices.push_back(i);
 		}
 	}
 
-	return nCuts;
-}
-
-int ofxGLayer::getValidCuts(array<array<float, 2>, 4>& cuts, int nCuts, const ofxGPoint& plotPoint1,
-		const ofxGPoint& plotPoint2) {
-	float x1 = plotPoint1.getX();
-	float y1 = plotPoint1.getY();
-	float x2 = plotPoint2.getX();
-	float y2 = plotPoint2.getY();
-	float deltaX = abs(x2 - x1);
-	float deltaY = abs(y2 - y1);
-	int counter = 0;
-
-	for (int i = 0; i < nCuts; ++i) {
-		// Check that the cut is inside the inner plotting area
-		if (isInside(cuts[i][0], cuts[i][1])) {
-			// Check that the cut falls between the two points
-			if (abs(cuts[i][0] - x1) <= deltaX && abs(cuts[i][1] - y1) <= deltaY && abs(cuts[i][0] - x2) <= deltaX
-					&& abs(cuts[i][1] - y2) <= deltaY) {
-				cuts[counter][0] = cuts[i][0];
-				cuts[counter][1] = cuts[i][1];
-				++counter;
+	// Select the points using the Largest-Triangle-Three-Buckets algorithm
+	vector<ofxGPointArray::size_type> selected;
+	ofxGPointArray::size_type nValid = validIndices.size();
+
+	if (nValid <= downsamplingPoints) {
+		selected = validIndices;
+	} else {
+		// The first and last points are always selected. The rest are divided in buckets. The bucket bounds are
+		// calculated in double precision, so they stay exact for large numbers of points
+		double bucketSize = double(nValid - 2) / (downsamplingPoints - 2);
+		ofxGPointArray::size_type previous = validIndices[0];
+		selected.push_back(previous);
+
+		for (ofxGPointArray::size_type b = 0; b < downsamplingPoints - 2; ++b) {
+			// Calculate the average point of the next bucket
+			ofxGPointArray::size_type nextStart = min(ofxGPointArray::size_type((b + 1) * bucketSize) + 1, nValid - 1);
+			ofxGPointArray::size_type nextEnd = min(ofxGPointArray::size_type((b + 2) * bucketSize) + 1, nValid);
+			nextEnd = max(nextEnd, nextStart + 1);
+			float xAvg = 0;
+			float yAvg = 0;
+
+			for (ofxGPointArray::size_type j = nextStart; j < nextEnd; ++j) {
+				xAvg += plotPoints.getX(validIndices[j]);
+				yAvg += plotPoints.getY(validIndices[j]);
 			}
-		}
-	}
 
-	return counter;
-}
+			xAvg /= nextEnd - nextStart;
+			yAvg /= nextEnd - nextStart;
 
-int ofxGLayer::removeDuplicatedCuts(array<array<float, 2>, 4>& cuts, int nCuts, float tolerance) {
-	int counter = 0;
+			// Select the bucket point that forms the largest triangle with the previous point and the average
+			ofxGPointArray::size_type start = ofxGPointArray::size_type(b * bucketSize) + 1;
+			ofxGPointArray::size_type end = ofxGPointArray::size_type((b + 1) * bucketSize) + 1;
+			float xPrevious = plotPoints.getX(previous);
+			float yPrevious = plotPoints.getY(previous);
+			float maxArea = -1;
 
-	for (int i = 0; i < nCuts; ++i) {
-		bool repeated = false;
+			for (ofxGPointArray::size_type j = start; j < end; ++j) {
+				ofxGPointArray::size_type i = validIndices[j];
+				float area = abs((xPrevious - xAvg) * (plotPoints.getY(i) - yPrevious)
+						- (xPrevious - plotPoints.getX(i)) * (yAvg - yPrevious));
 
-		for (int j = 0; j < counter; ++j) {
-			if (abs(cuts[j][0] - cuts[i][0]) <= tolerance && abs(cuts[j][1] - cuts[i][1]) <= tolerance) {
-				repeated = true;
-				break;
+				if (area > maxArea) {
+					maxArea = area;
+					previous = i;
+				}
 			}
-		}
 
-		if (!repeated) {
-			cuts[counter][0] = cuts[i][0];
-			cuts[counter][1] = cuts[i][1];
-			++counter;
+			selected.push_back(previous);
 		}
-	}
 
-	return counter;
-}
+		selected.push_back(validIndices[nValid - 1]);
+	}
 
-int ofxGLayer::removePointFromCuts(array<array<float, 2>, 4>& cuts, int nCuts, const ofxGPoint& plotPoint,
-		float tolerance) {
-	float x = plotPoint.getX();
-	float y = plotPoint.getY();
-	int counter = 0;
+	// Keep one invalid point between the selected points that had invalid points between them, so the lines are cut
+	sampledIndices.clear();
 
-	for (int i = 0; i < nCuts; ++i) {
-		if (abs(cuts[i][0] - x) > tolerance || abs(cuts[i][1] - y) > tolerance) {
-			cuts[counter][0] = cuts[i][0];
-			cuts[counter][1] = cuts[i][1];
-			++counter;
+	for (vector<ofxGPointArray::size_type>::size_type k = 0; k < selected.size(); ++k) {
+		if (k > 0) {
+			for (ofxGPointArray::size_type i = selected[k - 1] + 1; i < selected[k]; ++i) {
+				if (!plotPoints.isValid(i)) {
+					sampledIndices.push_back(i);
+					break;
+				}
+			}
 		}
+
+		sampledIndices.push_back(selected[k]);
 	}
 
-	return counter;
+	sampledIndicesNeedUpdate = false;
 }
 
-void ofxGLayer::startHistogram(ofxGHistogramType histType) {
-	hist = ofxGHistogram(histType, dim, plotPoints);
-	histIsActive = true;
-}
+const vector<glm::vec3>& ofxGLayer::clipPolygon(const vector<ofxGPoint>& polygonPoints) {
+	// Transform the valid polygon points to the plot reference system
+	polygonVertices.clear();
 
-void ofxGLayer::stopHistogram() {
-	histIsActive = false;
-}
-
-void ofxGLayer::drawPoints() const {
-	int nPoints = plotPoints.size();
-	int nColors = pointColors.size();
-	int nSizes = pointSizes.size();
+	for (const ofxGPoint& p : polygonPoints) {
+		float xPlot = valueToXPlot(p.getX());
+		float yPlot = valueToYPlot(p.getY());
 
-	ofPushStyle();
-	ofFill();
-
-	if (nColors == 1 && nSizes == 1) {
-		ofSetColor(pointColors[0]);
-
-		for (int i = 0; i < nPoints; ++i) {
-			if (inside[i]) {
-				ofDrawCircle(plotPoints[i].getX(), plotPoints[i].getY(), pointSizes[0]);
-			}
+		if (isfinite(xPlot) && isfinite(yPlot)) {
+			polygonVertices.emplace_back(xPlot, yPlot, 0);
 		}
-	} else if (nColors == 1) {
-		ofSetColor(pointColors[0]);
+	}
 
-		for (int i = 0; i < nPoints; ++i) {
-			if (inside[i]) {
-				ofDrawCircle(plotPoints[i].getX(), plotPoints[i].getY(), pointSizes[i % nSizes]);
-			}
-		}
-	} else if (nSizes == 1) {
-		for (int i = 0; i < nPoints; ++i) {
-			if (inside[i]) {
-				ofSetColor(pointColors[i % nColors]);
-				ofDrawCircle(plotPoints[i].getX(), plotPoints[i].getY(), pointSizes[0]);
-			}
-		}
-	} else {
-		for (int i = 0; i < nPoints; ++i) {
-			if (inside[i]) {
-				ofSetColor(pointColors[i % nColors]);
-				ofDrawCircle(plotPoints[i].getX(), plotPoints[i].getY(), pointSizes[i % nSizes]);
-			}
-		}
+	if (polygonVertices.size() < 3) {
+		polygonVertices.clear();
+		return polygonVertices;
 	}
 
-	ofPopStyle();
+	return polygonClipper.clip(polygonVertices, dim);
 }
 
-void ofxGLayer::drawPoints(const ofColor& pointColor) const {
+void ofxGLayer::updatePointsMesh(int circleResolution, bool withColors) const {
 	// Get the number of points inside the plot
+	const vector<ofxGPointArray::size_type>* sampled = getSampledIndices();
+	int nPoints = sampled ? sampled->size() : plotPoints.size();
 	int nPointsInside = 0;
 
-	for (bool isInside : inside) {
-		if (isInside) {
+	for (int k = 0; k < nPoints; ++k) {
+		int i = sampled ? (*sampled)[k] : k;
+
+		if (plotPoints.isInside(i)) {
 			++nPointsInside;
 		}
 	}
 
 	// Create the circle vertices
 	vector<glm::vec3> circleVertices;
-	int circleResolution = ofGetCurrentRenderer()->getPath().getCircleResolution();
 
 	for (int i = 0; i < circleResolution; ++i) {
 		float angle = i * TWO_PI / circleResolution;
@@ -490,22 +365,32 @@ void ofxGLayer::drawPoints(const ofColor& pointColor) const {
 	}
 
 	// Create the points mesh
-	ofMesh mesh = ofMesh();
-	vector<glm::vec3>& meshVertices = mesh.getVertices();
-	vector<ofIndexType>& meshIndices = mesh.getIndices();
+	pointsMesh.clear();
+	vector<glm::vec3>& meshVertices = pointsMesh.getVertices();
+	vector<ofIndexType>& meshIndices = pointsMesh.getIndices();
+	vector<ofFloatColor>& meshColors = pointsMesh.getColors();
 	meshVertices.resize((1 + circleResolution) * nPointsInside);
 	meshIndices.resize(3 * circleResolution * nPointsInside);
-	int nPoints = plotPoints.size();
+	meshColors.resize(withColors ? (1 + circleResolution) * nPointsInside : 0);
+	int nColors = pointColors.size();
 	int nSizes = pointSizes.size();
 	int verticesCounter = 0;
 	int indicesCounter = 0;
 
-	for (int i = 0; i < nPoints; ++i) {
-		if (inside[i]) {
-			float x = plotPoints[i].getX();
-			float y = plotPoints[i].getY();
+	for (int k = 0; k < nPoints; ++k) {
+		int i = sampled ? (*sampled)[k] : k;
+
+		if (plotPoints.isInside(i)) {
+			float x = plotPoints.getX(i);
+			float y = plotPoints.getY(i);
 			float radius = pointSizes[i % nSizes];
 
+			if (withColors) {
+				ofFloatColor color = pointColors[i % nColors];
+				fill(meshColors.begin() + verticesCounter, meshColors.begin() + verticesCounter + 1 + circleResolution,
+						color);
+			}
+
 			meshVertices[verticesCounter] = glm::vec3(x, y, 0);
 			int centerIndex = verticesCounter;
 			++verticesCounter;
@@ -530,44 +415,291 @@ void ofxGLayer::drawPoints(const ofColor& pointColor) const {
 		}
 	}
 
-	// Draw the mesh
+	pointsMeshNeedsUpdate = false;
+	pointsMeshCircleResolution = circleResolution;
+	pointsMeshHasColors = withColors;
+	++meshRebuildCount;
+}
+
+
+void ofxGLayer::updateLinesMesh() const {
+	// Create the lines mesh
+	linesMesh.clear();
+	linesMesh.setMode(OF_PRIMITIVE_LINES);
+	vector<glm::vec3>& meshVertices = linesMesh.getVertices();
+	ofxGLineClipper clipper(dim);
+	ofxGLineDecimator decimator(meshVertices);
+
+	// Clip the segments between consecutive valid points in small blocks, so they never need to be stored all
+	// together, and add their visible parts to the mesh or the decimator
+	const size_t blockSize = 256;
+	float x1[blockSize], y1[blockSize], x2[blockSize], y2[blockSize], t0[blockSize], t1[blockSize];
+	size_t nSegments = 0;
+
+	auto addBlock = [&]() {
+		clipper.clip(x1, y1, x2, y2, nSegments, t0, t1);
+
+		for (size_t s = 0; s < nSegments; ++s) {
+			if (t0[s] <= t1[s]) {
+				glm::vec3 start(x1[s], y1[s], 0);
+				glm::vec3 end(x2[s], y2[s], 0);
+
+				if (t0[s] > 0) {
+					array<float, 2> cut = clipper.getBorderPoint(x1[s], y1[s], x2[s], y2[s], t0[s]);
+					start = glm::vec3(cut[0], cut[1], 0);
+				}
+
+				if (t1[s] < 1) {
+					array<float, 2> cut = clipper.getBorderPoint(x1[s], y1[s], x2[s], y2[s], t1[s]);
+					end = glm::vec3(cut[0], cut[1], 0);
+				}
+
+				if (linesDecimation) {
+					decimator.addSegment(start, end);
+				} else {
+					meshVertices.push_back(start);
+					meshVertices.push_back(end);
+				}
+			}
+		}
+
+		nSegments = 0;
+	};
+
+	const vector<ofxGPointArray::size_type>* sampled = getSampledIndices();
+	ofxGPointArray::size_type nPoints = sampled ? sampled->size() : plotPoints.size();
+
+	for (ofxGPointArray::size_type k = 0; k + 1 < nPoints; ++k) {
+		ofxGPointArray::size_type i = sampled ? (*sampled)[k] : k;
+		ofxGPointArray::size_type j = sampled ? (*sampled)[k + 1] : k + 1;
+
+		if (plotPoints.isValid(i) && plotPoints.isValid(j)) {
+			x1[nSegments] = plotPoints.getX(i);
+			y1[nSegments] = plotPoints.getY(i);
+			x2[nSegments] = plotPoints.getX(j);
+			y2[nSegments] = plotPoints.getY(j);
+			++nSegments;
+
+			if (nSegments == blockSize) {
+				addBlock();
+			}
+		}
+	}
+
+	addBlock();
+
+	if (linesDecimation) {
+		decimator.flush();
+	}
+
+	linesMeshNeedsUpdate = false;
+	++meshRebuildCount;
+}
+
+void ofxGLayer::updateContourMesh(ofxGContourType contourType, float referenceValue) const {
+	// Get the points that compose the shape
+	vector<glm::vec2> shapePoints = getContourShape(contourType, referenceValue);
+
+	// Tessellate the shape
+	contourMesh.clear();
+	ofPolyline contourLine;
+
+	for (const glm::vec2& p : shapePoints) {
+		if (isfinite(p.x) && isfinite(p.y)) {
+			contourLine.addVertex(p.x, p.y);
+		}
+	}
+
+	if (contourLine.size() > 2) {
+		contourLine.close();
+		ofTessellator tessellator;
+		tessellator.tessellateToMesh(contourLine, OF_POLY_WINDING_ODD, contourMesh, true);
+	}
+
+	contourMeshNeedsUpdate = false;
+	contourMeshType = contourType;
+	contourMeshReferenceValue = referenceValue;
+	++meshRebuildCount;
+}
+
+float ofxGLayer::xPlotToValue(float xPlot) const {
+	if (xLogScale) {
+		return pow(10, log10(xLim[0]) + log10(xLim[1] / xLim[0]) * xPlot / dim[0]);
+	} else {
+		return xLim[0] + (xLim[1] - xLim[0]) * xPlot / dim[0];
+	}
+}
+
+float ofxGLayer::yPlotToValue(float yPlot) const {
+	if (yLogScale) {
+		return pow(10, log10(yLim[0]) - log10(yLim[1] / yLim[0]) * yPlot / dim[1]);
+	} else {
+		return yLim[0] - (yLim[1] - yLim[0]) * yPlot / dim[1];
+	}
+}
+
+array<float, 2> ofxGLayer::plotToValue(float xPlot, float yPlot) const {
+	return {xPlotToValue(xPlot), yPlotToValue(yPlot)};
+}
+
+bool ofxGLayer::isInside(float xPlot, float yPlot) const {
+	return (xPlot >= 0) && (xPlot <= dim[0]) && (-yPlot >= 0) && (-yPlot <= dim[1]);
+}
+
+bool ofxGLayer::isInside(const ofxGPoint& plotPoint) const {
+	return plotPoint.isValid() ? isInside(plotPoint.getX(), plotPoint.getY()) : false;
+}
+
+vector<bool> ofxGLayer::isInside(const vector<ofxGPoint>& plotPts) const {
+	vector<bool> pointsInside;
+
+	for (const ofxGPoint& p : plotPts) {
+		pointsInside.push_back(isInside(p));
+	}
+
+	return pointsInside;
+}
+
+vector<ofxGPoint>::size_type ofxGLayer::getPointIndexAtPlotPos(float xPlot, float yPlot) const {
+	vector<ofxGPoint>::size_type pointIndex = plotPoints.size();
+
+	if (isInside(xPlot, yPlot)) {
+		// Rebuild the points grid if it's outdated. The cell size should cover the largest search radius
+		if (pointsGridNeedsUpdate) {
+			float cellSize = max(*max_element(pointSizes.begin(), pointSizes.end()), 5.0f);
+			pointsGrid.build(plotPoints, getSampledIndices(), dim, cellSize);
+			pointsGridNeedsUpdate = false;
+		}
+
+		pointIndex = pointsGrid.findClosest(plotPoints, xPlot, yPlot, pointSizes, 5);
+	}
+
+	return pointIndex;
+}
+
+const ofxGPoint* ofxGLayer::getPointAtPlotPos(float xPlot, float yPlot) const {
+	vector<ofxGPoint>::size_type pointIndex = getPointIndexAtPlotPos(xPlot, yPlot);
+
+	if (pointIndex < points.size()) {
+		selectedPoint = points[pointIndex];
+		return &selectedPoint;
+	}
+
+	return nullptr;
+}
+
+void ofxGLayer::beginUpdate() {
+	++updateDepth;
+}
+
+void ofxGLayer::endUpdate() {
+	if (updateDepth == 0) {
+		ofLogWarning("endUpdate() was called without a matching beginUpdate()");
+		return;
+	}
+
+	--updateDepth;
+
+	// Recalculate the plot points and the histogram once
+	if (updateDepth == 0 && plotPointsNeedUpdate) {
+		updatePlotPoints();
+		plotPointsNeedUpdate = false;
+
+		if (histIsActive) {
+			hist.setPlotPoints(plotPoints);
+		}
+	}
+}
+
+void ofxGLayer::startHistogram(ofxGHistogramType histType) {
+	hist = ofxGHistogram(histType, dim, plotPoints);
+	histIsActive = true;
+}
+
+void ofxGLayer::stopHistogram() {
+	histIsActive = false;
+}
+
+void ofxGLayer::drawPoints() const {
+	// Rebuild the points mesh only if it's outdated. The per-vertex colors are only needed for multiple point colors
+	int circleResolution = ofGetCurrentRenderer()->getPath().getCircleResolution();
+	bool withColors = pointColors.size() > 1;
+
+	if (pointsMeshNeedsUpdate || circleResolution != pointsMeshCircleResolution
+			|| (withColors && !pointsMeshHasColors)) {
+		updatePointsMesh(circleResolution, withColors);
+	}
+
+	// Draw the mesh using the point colors
+	ofPushStyle();
+	ofFill();
+	ofSetColor(pointsMeshHasColors ? ofColor(255) : pointColors[0]);
+	pointsMesh.draw();
+	ofPopStyle();
+}
+
+void ofxGLayer::drawPoints(const ofColor& pointColor) const {
+	// Rebuild the points mesh only if it's outdated. A new mesh doesn't need the point colors
+	int circleResolution = ofGetCurrentRenderer()->getPath().getCircleResolution();
+
+	if (pointsMeshNeedsUpdate || circleResolution != pointsMeshCircleResolution) {
+		updatePointsMesh(circleResolution, false);
+	}
+
+	// Draw the mesh ignoring the point colors
 	ofPushStyle();
 	ofFill();
 	ofSetColor(pointColor);
-	mesh.draw();
+
+	if (pointsMeshHasColors) {
+		pointsMesh.disableColors();
+		pointsMesh.draw();
+		pointsMesh.enableColors();
+	} else {
+		pointsMesh.draw();
+	}
+
 	ofPopStyle();
 }
 
 void ofxGLayer::drawPoints(ofPath& pointShape) const {
-	int nPoints = plotPoints.size();
+	const vector<ofxGPointArray::size_type>* sampled = getSampledIndices();
+	int nPoints = sampled ? sampled->size() : plotPoints.size();
 	int nColors = pointColors.size();
 
 	if (nColors == 1) {
 		pointShape.setColor(pointColors[0]);
 
-		for (int i = 0; i < nPoints; ++i) {
-			if (inside[i]) {
-				pointShape.draw(plotPoints[i].getX(), plotPoints[i].getY());
+		for (int k = 0; k < nPoints; ++k) {
+			int i = sampled ? (*sampled)[k] : k;
+
+			if (plotPoints.isInside(i)) {
+				pointShape.draw(plotPoints.getX(i), plotPoints.getY(i));
 			}
 		}
 	} else {
-		for (int i = 0; i < nPoints; ++i) {
-			if (inside[i]) {
+		for (int k = 0; k < nPoints; ++k) {
+			int i = sampled ? (*sampled)[k] : k;
+
+			if (plotPoints.isInside(i)) {
 				pointShape.setColor(pointColors[i % nColors]);
-				pointShape.draw(plotPoints[i].getX(), plotPoints[i].getY());
+				pointShape.draw(plotPoints.getX(i), plotPoints.getY(i));
 			}
 		}
 	}
 }
 
 void ofxGLayer::drawPoints(const ofImage& pointImg) const {
-	int nPoints = plotPoints.size();
+	const vector<ofxGPointArray::size_type>* sampled = getSampledIndices();
+	int nPoints = sampled ? sampled->size() : plotPoints.size();
 	int imgWidth = pointImg.getWidth();
 	int imgHeight = pointImg.getHeight();
 
-	for (int i = 0; i < nPoints; ++i) {
-		if (inside[i]) {
-			pointImg.draw(plotPoints[i].getX() - imgWidth / 2, plotPoints[i].getY() - imgHeight / 2);
+	for (int k = 0; k < nPoints; ++k) {
+		int i = sampled ? (*sampled)[k] : k;
+
+		if (plotPoints.isInside(i)) {
+			pointImg.draw(plotPoints.getX(i) - imgWidth / 2, plotPoints.getY(i) - imgHeight / 2);
 		}
 	}
 }
@@ -617,45 +749,23 @@ void ofxGLayer::drawPoint(const ofxGPoint& point, const ofImage& pointImg) const
 	}
 }
 
-void ofxGLayer::drawLines() {
+void ofxGLayer::drawLines() const {
 	if (plotPoints.size() > 1) {
-		// Create the lines mesh
-		ofMesh mesh = ofMesh();
-		mesh.setMode(OF_PRIMITIVE_LINES);
-		vector<glm::vec3>& meshVertices = mesh.getVertices();
-
-		for (vector<ofxGPoint>::size_type i = 0; i < plotPoints.size() - 1; ++i) {
-			if (inside[i] && inside[i + 1]) {
-				meshVertices.emplace_back(plotPoints[i].getX(), plotPoints[i].getY(), 0);
-				meshVertices.emplace_back(plotPoints[i + 1].getX(), plotPoints[i + 1].getY(), 0);
-			} else if (plotPoints[i].isValid() && plotPoints[i + 1].isValid()) {
-				// At least one of the points is outside the inner region.
-				// Obtain the valid line box intersections
-				int nCuts = obtainBoxIntersections(plotPoints[i], plotPoints[i + 1]);
-
-				if (inside[i]) {
-					meshVertices.emplace_back(plotPoints[i].getX(), plotPoints[i].getY(), 0);
-					meshVertices.emplace_back(cuts[0][0], cuts[0][1], 0);
-				} else if (inside[i + 1]) {
-					meshVertices.emplace_back(cuts[0][0], cuts[0][1], 0);
-					meshVertices.emplace_back(plotPoints[i + 1].getX(), plotPoints[i + 1].getY(), 0);
-				} else if (nCuts >= 2) {
-					meshVertices.emplace_back(cuts[0][0], cuts[0][1], 0);
-					meshVertices.emplace_back(cuts[1][0], cuts[1][1], 0);
-				}
-			}
+		// Rebuild the lines mesh only if it's outdated
+		if (linesMeshNeedsUpdate) {
+			updateLinesMesh();
 		}
 
 		// Draw the mesh
 		ofPushStyle();
 		ofSetColor(lineColor);
 		ofSetLineWidth(lineWidth);
-		mesh.draw();
+		linesMesh.draw();
 		ofPopStyle();
 	}
 }
 
-void ofxGLayer::drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lc, float lw) {
+void ofxGLayer::drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lc, float lw) const {
 	ofxGPoint plotPoint1 = valueToPlot(point1);
 	ofxGPoint plotPoint2 = valueToPlot(point2);
 
@@ -671,11 +781,13 @@ void ofxGLayer::drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const
 			ofDrawLine(plotPoint1.getX(), plotPoint1.getY(), plotPoint2.getX(), plotPoint2.getY());
 		} else {
 			// At least one of the points is outside the inner region. Obtain the valid line box intersections
-			int nCuts = obtainBoxIntersections(plotPoint1, plotPoint2);
+			array<array<float, 2>, 2> cuts;
+			int nCuts = ofxGLineClipper(dim).getCuts(plotPoint1.getX(), plotPoint1.getY(), plotPoint2.getX(),
+					plotPoint2.getY(), cuts);
 
-			if (inside1) {
+			if (inside1 && nCuts == 1) {
 				ofDrawLine(plotPoint1.getX(), plotPoint1.getY(), cuts[0][0], cuts[0][1]);
-			} else if (inside2) {
+			} else if (inside2 && nCuts == 1) {
 				ofDrawLine(cuts[0][0], cuts[0][1], plotPoint2.getX(), plotPoint2.getY());
 			} else if (nCuts >= 2) {
 				ofDrawLine(cuts[0][0], cuts[0][1], cuts[1][0], cuts[1][1]);
@@ -686,11 +798,11 @@ void ofxGLayer::drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const
 	}
 }
 
-void ofxGLayer::drawLine(const ofxGPoint& point1, const ofxGPoint& point2) {
+void ofxGLayer::drawLine(const ofxGPoint& point1, const ofxGPoint& point2) const {
 	drawLine(point1, point2, lineColor, lineWidth);
 }
 
-void ofxGLayer::drawLine(float slope, float yCut, const ofColor& lc, float lw) {
+void ofxGLayer::drawLine(float slope, float yCut, const ofColor& lc, float lw) const {
 	if (xLogScale && yLogScale) {
 		ofxGPoint point1 = ofxGPoint(xLim[0], pow(10, slope * log10(xLim[0]) + yCut));
 		ofxGPoint point2 = ofxGPoint(xLim[1], pow(10, slope * log10(xLim[1]) + yCut));
@@ -710,7 +822,7 @@ void ofxGLayer::drawLine(float slope, float yCut, const ofColor& lc, float lw) {
 	}
 }
 
-void ofxGLayer::drawLine(float slope, float yCut) {
+void ofxGLayer::drawLine(float slope, float yCut) const {
 	drawLine(slope, yCut, lineColor, lineWidth);
 }
 
@@ -746,309 +858,193 @@ void ofxGLayer::drawVerticalLine(float value) const {
 	drawVerticalLine(value, lineColor, lineWidth);
 }
 
-void ofxGLayer::drawFilledContour(ofxGContourType contourType, float referenceValue) {
-	// Get the points that compose the shape
-	vector<ofxGPoint> shapePoints;
-
-	if (contourType == GRAFICA_HORIZONTAL_CONTOUR) {
-		shapePoints = getHorizontalShape(referenceValue);
-	} else {
-		shapePoints = getVerticalShape(referenceValue);
+void ofxGLayer::drawFilledContour(ofxGContourType contourType, float referenceValue) const {
+	// Rebuild the contour mesh only if it's outdated
+	if (contourMeshNeedsUpdate || contourType != contourMeshType || referenceValue != contourMeshReferenceValue) {
+		updateContourMesh(contourType, referenceValue);
 	}
 
-	// Draw the shape
-	if (shapePoints.size() > 0) {
-		ofPushStyle();
-		ofFill();
-		ofSetColor(lineColor);
-
-		ofBeginShape();
-
-		for (const ofxGPoint& p : shapePoints) {
-			if (p.isValid()) {
-				ofVertex(p.getX(), p.getY());
-			}
-		}
-
-		ofEndShape(true);
-
-		ofPopStyle();
-	}
+	// Draw the mesh
+	ofPushStyle();
+	ofFill();
+	ofSetColor(lineColor);
+	contourMesh.draw();
+	ofPopStyle();
 }
 
-vector<ofxGPoint> ofxGLayer::getHorizontalShape(float referenceValue) {
-	// Collect the points and cuts inside the box
+vector<glm::vec2> ofxGLayer::getContourShape(ofxGContourType contourType, float referenceValue) const {
+	// The shape is calculated in box coordinates (x, -y), that go from 0 to dim in both directions. The contour
+	// follows the points along the first axis and closes at the reference value in the second axis
+	int along = (contourType == GRAFICA_HORIZONTAL_CONTOUR) ? 0 : 1;
+	int across = 1 - along;
 	int nPoints = plotPoints.size();
-	vector<ofxGPoint> shapePoints;
+	vector<glm::vec2> shapePoints;
+	ofxGShapeVertexType firstPointType = GRAFICA_POINT_VERTEX;
+	ofxGShapeVertexType lastPointType = GRAFICA_POINT_VERTEX;
 	int indexFirstPoint = -1;
 	int indexLastPoint = -1;
 
-	for (int i = 0; i < nPoints; ++i) {
-		if (plotPoints[i].isValid()) {
-			bool addedPoints = false;
-
-			// Add the point if it's inside the box
-			if (inside[i]) {
-				shapePoints.emplace_back(plotPoints[i].getX(), plotPoints[i].getY(), "normal point");
-				addedPoints = true;
-			} else if (plotPoints[i].getX() >= 0 && plotPoints[i].getX() <= dim[0]) {
-				// If it's outside, add the projection of the point on the horizontal axes
-				if (-plotPoints[i].getY() < 0) {
-					shapePoints.emplace_back(plotPoints[i].getX(), 0, "projection");
-					addedPoints = true;
-				} else {
-					shapePoints.emplace_back(plotPoints[i].getX(), -dim[1], "projection");
-					addedPoints = true;
-				}
-			}
-
-			// Add the box cuts if there is any
-			int nextIndex = i + 1;
-
-			while (nextIndex < nPoints - 1 && !plotPoints[nextIndex].isValid()) {
-				++nextIndex;
-			}
+	auto addVertex = [&](const array<float, 2>& boxPos, ofxGShapeVertexType type) {
+		if (shapePoints.empty()) {
+			firstPointType = type;
+		}
 
-			if (nextIndex < nPoints && plotPoints[nextIndex].isValid()) {
-				int nCuts = obtainBoxIntersections(plotPoints[i], plotPoints[nextIndex]);
+		lastPointType = type;
+		shapePoints.emplace_back(boxPos[0], -boxPos[1]);
+	};
 
-				for (int j = 0; j < nCuts; ++j) {
-					shapePoints.emplace_back(cuts[j][0], cuts[j][1], "cut");
-					addedPoints = true;
-				}
-			}
+	auto getBoxPos = [&](int index) -> array<float, 2> {
+		return {plotPoints.getX(index), -plotPoints.getY(index)};
+	};
 
-			if (addedPoints) {
-				if (indexFirstPoint < 0) {
-					indexFirstPoint = i;
-				}
+	// Collect the points and cuts inside the box. The segments between consecutive valid points are clipped in small
+	// blocks, and the last valid point is clipped as a zero length segment, which never has cuts
+	ofxGLineClipper clipper(dim);
+	const int blockSize = 256;
+	int indices[blockSize];
+	float x1[blockSize], y1[blockSize], x2[blockSize], y2[blockSize], t0[blockSize], t1[blockSize];
+	int i = 0;
 
-				indexLastPoint = i;
-			}
-		}
+	while (i < nPoints && !plotPoints.isValid(i)) {
+		++i;
 	}
 
-	// Continue if there are points in the shape
-	if (shapePoints.size() > 0) {
-		// Calculate the starting point
-		ofxGPoint startPoint = shapePoints[0];
-
-		if (startPoint.getX() != 0 && startPoint.getX() != dim[0]) {
-			if (startPoint.getLabel() == "cut") {
-				if (plotPoints[indexFirstPoint].getX() < 0) {
-					startPoint.setX(0);
-					startPoint.setLabel("extreme");
-				} else {
-					startPoint.setX(dim[0]);
-					startPoint.setLabel("extreme");
-				}
-			} else if (indexFirstPoint != 0) {
-				// Get the previous valid point
-				int prevIndex = indexFirstPoint - 1;
-
-				while (prevIndex > 0 && !plotPoints[prevIndex].isValid()) {
-					--prevIndex;
-				}
-
-				if (plotPoints[prevIndex].isValid()) {
-					if (plotPoints[prevIndex].getX() < 0) {
-						startPoint.setX(0);
-						startPoint.setLabel("extreme");
-					} else {
-						startPoint.setX(dim[0]);
-						startPoint.setLabel("extreme");
-					}
-				}
-			}
-		}
-
-		// Calculate the end point
-		ofxGPoint endPoint = shapePoints.back();
+	while (i < nPoints) {
+		int nSegments = 0;
 
-		if (endPoint.getX() != 0 && endPoint.getX() != dim[0] && indexLastPoint != nPoints - 1) {
-			int nextIndex = indexLastPoint + 1;
+		while (nSegments < blockSize && i < nPoints) {
+			int nextIndex = i + 1;
 
-			while (nextIndex < nPoints - 1 && !plotPoints[nextIndex].isValid()) {
+			while (nextIndex < nPoints && !plotPoints.isValid(nextIndex)) {
 				++nextIndex;
 			}
 
-			if (plotPoints[nextIndex].isValid()) {
-				if (plotPoints[nextIndex].getX() < 0) {
-					endPoint.setX(0);
-					endPoint.setLabel("extreme");
-				} else {
-					endPoint.setX(dim[0]);
-					endPoint.setLabel("extreme");
-				}
-			}
-		}
-
-		// Add the end point if it's a new extreme
-		if (endPoint.getLabel() == "extreme") {
-			shapePoints.push_back(endPoint);
-		}
-
-		// Add the reference connections
-		if (yLogScale && referenceValue <= 0) {
-			referenceValue = min(yLim[0], yLim[1]);
-		}
-
-		array<float, 2> plotReference = valueToPlot(1, referenceValue);
-
-		if (-plotReference[1] < 0) {
-			shapePoints.emplace_back(endPoint.getX(), 0);
-			shapePoints.emplace_back(startPoint.getX(), 0);
-		} else if (-plotReference[1] > dim[1]) {
-			shapePoints.emplace_back(endPoint.getX(), -dim[1]);
-			shapePoints.emplace_back(startPoint.getX(), -dim[1]);
-		} else {
-			shapePoints.emplace_back(endPoint.getX(), plotReference[1]);
-			shapePoints.emplace_back(startPoint.getX(), plotReference[1]);
-		}
-
-		// Add the starting point if it's a new extreme
-		if (startPoint.getLabel() == "extreme") {
-			shapePoints.push_back(startPoint);
+			int endIndex = (nextIndex < nPoints) ? nextIndex : i;
+			indices[nSegments] = i;
+			x1[nSegments] = plotPoints.getX(i);
+			y1[nSegments] = plotPoints.getY(i);
+			x2[nSegments] = plotPoints.getX(endIndex);
+			y2[nSegments] = plotPoints.getY(endIndex);
+			++nSegments;
+			i = nextIndex;
 		}
-	}
 
-	return shapePoints;
-}
+		clipper.clip(x1, y1, x2, y2, nSegments, t0, t1);
 
-vector<ofxGPoint> ofxGLayer::getVerticalShape(float referenceValue) {
-	// Collect the points and cuts inside the box
-	int nPoints = plotPoints.size();
-	vector<ofxGPoint> shapePoints;
-	int indexFirstPoint = -1;
-	int indexLastPoint = -1;
+		for (int k = 0; k < nSegments; ++k) {
+			size_t nShapePoints = shapePoints.size();
+			array<float, 2> boxPos = {x1[k], -y1[k]};
 
-	for (int i = 0; i < nPoints; ++i) {
-		if (plotPoints[i].isValid()) {
-			bool addedPoints = false;
-
-			// Add the point if it's inside the box
-			if (inside[i]) {
-				shapePoints.emplace_back(plotPoints[i].getX(), plotPoints[i].getY(), "normal point");
-				addedPoints = true;
-			} else if (-plotPoints[i].getY() >= 0 && -plotPoints[i].getY() <= dim[1]) {
-				// If it's outside, add the projection of the point on the vertical axes
-				if (plotPoints[i].getX() < 0) {
-					shapePoints.emplace_back(0, plotPoints[i].getY(), "projection");
-					addedPoints = true;
-				} else {
-					shapePoints.emplace_back(dim[0], plotPoints[i].getY(), "projection");
-					addedPoints = true;
-				}
+			if (isInside(x1[k], y1[k])) {
+				// Add the point if it's inside the box
+				addVertex(boxPos, GRAFICA_POINT_VERTEX);
+			} else if (boxPos[along] >= 0 && boxPos[along] <= dim[along]) {
+				// If it's outside, add the projection of the point on the closest box border
+				boxPos[across] = (boxPos[across] < 0) ? 0 : dim[across];
+				addVertex(boxPos, GRAFICA_PROJECTION_VERTEX);
 			}
 
 			// Add the box cuts if there is any
-			int nextIndex = i + 1;
-
-			while (nextIndex < nPoints - 1 && !plotPoints[nextIndex].isValid()) {
-				++nextIndex;
-			}
-
-			if (nextIndex < nPoints && plotPoints[nextIndex].isValid()) {
-				int nCuts = obtainBoxIntersections(plotPoints[i], plotPoints[nextIndex]);
+			if (t0[k] <= t1[k]) {
+				if (t0[k] > 0) {
+					array<float, 2> cut = clipper.getBorderPoint(x1[k], y1[k], x2[k], y2[k], t0[k]);
+					addVertex({cut[0], -cut[1]}, GRAFICA_CUT_VERTEX);
+				}
 
-				for (int j = 0; j < nCuts; ++j) {
-					shapePoints.emplace_back(cuts[j][0], cuts[j][1], "cut");
-					addedPoints = true;
+				if (t1[k] < 1) {
+					array<float, 2> cut = clipper.getBorderPoint(x1[k], y1[k], x2[k], y2[k], t1[k]);
+					addVertex({cut[0], -cut[1]}, GRAFICA_CUT_VERTEX);
 				}
 			}
 
-			if (addedPoints) {
+			if (shapePoints.size() > nShapePoints) {
 				if (indexFirstPoint < 0) {
-					indexFirstPoint = i;
+					indexFirstPoint = indices[k];
 				}
 
-				indexLastPoint = i;
+				indexLastPoint = indices[k];
 			}
 		}
 	}
 
 	// Continue if there are points in the shape
-	if (shapePoints.size() > 0) {
-		// Calculate the starting point
-		ofxGPoint startPoint = shapePoints[0];
-
-		if (startPoint.getY() != 0 && startPoint.getY() != -dim[1]) {
-			if (startPoint.getLabel() == "cut") {
-				if (-plotPoints[indexFirstPoint].getY() < 0) {
-					startPoint.setY(0);
-					startPoint.setLabel("extreme");
-				} else {
-					startPoint.setY(-dim[1]);
-					startPoint.setLabel("extreme");
-				}
-			} else if (indexFirstPoint != 0) {
-				// Get the previous valid point
-				int prevIndex = indexFirstPoint - 1;
+	if (shapePoints.empty()) {
+		return shapePoints;
+	}
 
-				while (prevIndex > 0 && !plotPoints[prevIndex].isValid()) {
-					--prevIndex;
-				}
+	// Calculate the starting point
+	array<float, 2> startPoint = {shapePoints[0].x, -shapePoints[0].y};
+	ofxGShapeVertexType startPointType = firstPointType;
 
-				if (plotPoints[prevIndex].isValid()) {
-					if (-plotPoints[prevIndex].getY() < 0) {
-						startPoint.setY(0);
-						startPoint.setLabel("extreme");
-					} else {
-						startPoint.setY(-dim[1]);
-						startPoint.setLabel("extreme");
-					}
-				}
+	if (startPoint[along] != 0 && startPoint[along] != dim[along]) {
+		if (startPointType == GRAFICA_CUT_VERTEX) {
+			startPoint[along] = (getBoxPos(indexFirstPoint)[along] < 0) ? 0 : dim[along];
+			startPointType = GRAFICA_EXTREME_VERTEX;
+		} else if (indexFirstPoint != 0) {
+			// Get the previous valid point
+			int prevIndex = indexFirstPoint - 1;
+
+			while (prevIndex > 0 && !plotPoints.isValid(prevIndex)) {
+				--prevIndex;
+			}
+
+			if (plotPoints.isValid(prevIndex)) {
+				startPoint[along] = (getBoxPos(prevIndex)[along] < 0) ? 0 : dim[along];
+				startPointType = GRAFICA_EXTREME_VERTEX;
 			}
 		}
+	}
 
-		// Calculate the end point
-		ofxGPoint endPoint = shapePoints.back();
+	// Calculate the end point
+	array<float, 2> endPoint = {shapePoints.back().x, -shapePoints.back().y};
+	ofxGShapeVertexType endPointType = lastPointType;
 
-		if (endPoint.getY() != 0 && endPoint.getY() != -dim[1] && indexLastPoint != nPoints - 1) {
-			int nextIndex = indexLastPoint + 1;
+	if (endPoint[along] != 0 && endPoint[along] != dim[along] && indexLastPoint != nPoints - 1) {
+		int nextIndex = indexLastPoint + 1;
 
-			while (nextIndex < nPoints - 1 && !plotPoints[nextIndex].isValid()) {
-				++nextIndex;
-			}
+		while (nextIndex < nPoints - 1 && !plotPoints.isValid(nextIndex)) {
+			++nextIndex;
+		}
 
-			if (plotPoints[nextIndex].isValid()) {
-				if (-plotPoints[nextIndex].getY() < 0) {
-					endPoint.setY(0);
-					endPoint.setLabel("extreme");
-				} else {
-					endPoint.setY(-dim[1]);
-					endPoint.setLabel("extreme");
-				}
-			}
+		if (plotPoints.isValid(nextIndex)) {
+			endPoint[along] = (getBoxPos(nextIndex)[along] < 0) ? 0 : dim[along];
+			endPointType = GRAFICA_EXTREME_VERTEX;
 		}
+	}
 
-		// Add the end point if it's a new extreme
-		if (endPoint.getLabel() == "extreme") {
-			shapePoints.push_back(endPoint);
+	// Add the end point if it's a new extreme
+	if (endPointType == GRAFICA_EXTREME_VERTEX) {
+		addVertex(endPoint, endPointType);
+	}
+
+	// Add the reference connections
+	float reference;
+
+	if (contourType == GRAFICA_HORIZONTAL_CONTOUR) {
+		if (yLogScale && referenceValue <= 0) {
+			referenceValue = min(yLim[0], yLim[1]);
 		}
 
-		// Add the reference connections
+		reference = -valueToYPlot(referenceValue);
+	} else {
 		if (xLogScale && referenceValue <= 0) {
 			referenceValue = min(xLim[0], xLim[1]);
 		}
 
-		array<float, 2> plotReference = valueToPlot(referenceValue, 1);
+		reference = valueToXPlot(referenceValue);
+	}
 
-		if (plotReference[0] < 0) {
-			shapePoints.emplace_back(0, endPoint.getY());
-			shapePoints.emplace_back(0, startPoint.getY());
-		} else if (plotReference[0] > dim[0]) {
-			shapePoints.emplace_back(dim[0], endPoint.getY());
-			shapePoints.emplace_back(dim[0], startPoint.getY());
-		} else {
-			shapePoints.emplace_back(plotReference[0], endPoint.getY());
-			shapePoints.emplace_back(plotReference[0], startPoint.getY());
-		}
+	reference = ofClamp(reference, 0, dim[across]);
+	array<float, 2> endReference = endPoint;
+	array<float, 2> startReference = startPoint;
+	endReference[across] = reference;
+	startReference[across] = reference;
+	addVertex(endReference, GRAFICA_PROJECTION_VERTEX);
+	addVertex(startReference, GRAFICA_PROJECTION_VERTEX);
 
-		// Add the starting point if it's a new extreme
-		if (startPoint.getLabel() == "extreme") {
-			shapePoints.emplace_back(startPoint);
-		}
+	// Add the starting point if it's a new extreme
+	if (startPointType == GRAFICA_EXTREME_VERTEX) {
+		addVertex(startPoint, startPointType);
 	}
 
 	return shapePoints;
@@ -1063,7 +1059,7 @@ void ofxGLayer::drawLabel(const ofxGPoint& point) const {
 		float yLabelPos = yPlot - labelSeparation[1];
 		float delta = fontSize / 2.0;
 
-		ofRectangle bounds = font.getStringBoundingBox(point.getLabel(), 0, 0);
+		ofRectangle bounds = font->getStringBoundingBox(point.getLabel(), 0, 0);
 
 		ofPushStyle();
 		ofFill();
@@ -1072,7 +1068,7 @@ void ofxGLayer::drawLabel(const ofxGPoint& point) const {
 		ofDrawRectangle(xLabelPos - delta, yLabelPos - fontSize - delta, bounds.width + 2 * delta,
 				fontSize + 2 * delta);
 		ofSetColor(fontColor);
-		font.drawString(point.getLabel(), xLabelPos, yLabelPos);
+		font->drawString(point.getLabel(), xLabelPos, yLabelPos);
 		ofPopStyle();
 	}
 }
@@ -1091,92 +1087,67 @@ void ofxGLayer::drawHistogram() const {
 	}
 }
 
-void ofxGLayer::drawPolygon(const vector<ofxGPoint>& polygonPoints, const ofColor& polygonColor) {
-	if (polygonPoints.size() > 2) {
-		vector<ofxGPoint> plotPolygonPoints = valueToPlot(polygonPoints);
-
-		// Remove the polygon invalid points
-		vector<ofxGPoint> cleanPoints;
+void ofxGLayer::drawDensity() const {
+	if (densityMapNeedsUpdate) {
+		densityMap.update(plotPoints, dim);
+		densityMapNeedsUpdate = false;
+	}
 
-		for (const ofxGPoint& p : plotPolygonPoints) {
-			if (p.isValid()) {
-				cleanPoints.push_back(p);
-			}
-		}
+	ofPushStyle();
+	ofSetColor(255);
+	densityMap.draw();
+	ofPopStyle();
+}
 
-		// Create a temporal array with the points inside the plotting area and the valid box cuts
-		vector<ofxGPoint> tmp;
-		int nPoints = cleanPoints.size();
+void ofxGLayer::drawPolygon(const vector<ofxGPoint>& polygonPoints, const ofColor& polygonColor) {
+	const vector<glm::vec3>& clippedPolygon = clipPolygon(polygonPoints);
 
-		for (int i = 0; i < nPoints; ++i) {
-			if (isInside(cleanPoints[i])) {
-				tmp.emplace_back(cleanPoints[i].getX(), cleanPoints[i].getY(), "normal point");
-			}
+	// Draw the clipped polygon
+	if (clippedPolygon.size() > 2) {
+		ofPushStyle();
+		ofFill();
+		ofSetColor(polygonColor);
 
-			// Obtain the cuts with the next point
-			int nextIndex = (i + 1 < nPoints) ? i + 1 : 0;
-			int nCuts = obtainBoxIntersections(cleanPoints[i], cleanPoints[nextIndex]);
+		ofBeginShape();
 
-			if (nCuts == 1) {
-				tmp.emplace_back(cuts[0][0], cuts[0][1], "single cut");
-			} else if (nCuts > 1) {
-				tmp.emplace_back(cuts[0][0], cuts[0][1], "double cut");
-				tmp.emplace_back(cuts[1][0], cuts[1][1], "double cut");
-			}
+		for (const glm::vec3& v : clippedPolygon) {
+			ofVertex(v.x, v.y);
 		}
 
-		// Final version of the polygon
-		nPoints = tmp.size();
-		vector<ofxGPoint> croppedPoly;
-
-		for (int i = 0; i < nPoints; ++i) {
-			// Add the point
-			croppedPoly.push_back(tmp[i]);
-
-			// Add new points in case we have two consecutive cuts, one of them is single, and they are in
-			// consecutive axes
-			int nextIndex = (i + 1 < nPoints) ? i + 1 : 0;
-			string label = tmp[i].getLabel();
-			string nextLabel = tmp[nextIndex].getLabel();
-
-			bool cond = (label == "single cut" && nextLabel == "single cut")
-					|| (label == "single cut" && nextLabel == "double cut")
-					|| (label == "double cut" && nextLabel == "single cut");
-
-			if (cond) {
-				float x1 = tmp[i].getX();
-				float y1 = tmp[i].getY();
-				float x2 = tmp[nextIndex].getX();
-				float y2 = tmp[nextIndex].getY();
-				float deltaX = abs(x2 - x1);
-				float deltaY = abs(y2 - y1);
-
-				// Check that they come from consecutive axes
-				if (deltaX > 0 && deltaY > 0 && deltaX != dim[0] && deltaY != dim[1]) {
-					float x = (x1 == 0 || x1 == dim[0]) ? x1 : x2;
-					float y = (y1 == 0 || y1 == -dim[1]) ? y1 : y2;
-					croppedPoly.emplace_back(x, y, "special cut");
-				}
-			}
-		}
+		ofEndShape(true);
 
-		// Draw the cropped polygon
-		if (croppedPoly.size() > 2) {
-			ofPushStyle();
-			ofFill();
-			ofSetColor(polygonColor);
+		ofPopStyle();
+	}
+}
 
-			ofBeginShape();
+void ofxGLayer::drawPolygons(const vector<vector<ofxGPoint>>& polygons, const vector<ofColor>& polygonColors) {
+	if (polygonColors.size() == 0) {
+		throw invalid_argument("The vector is empty.");
+	}
 
-			for (const ofxGPoint& p : croppedPoly) {
-				ofVertex(p.getX(), p.getY());
-			}
+	// Tessellate the clipped polygons and add them to a single mesh
+	int nColors = polygonColors.size();
+	polygonsMesh.clear();
 
-			ofEndShape(true);
+	for (vector<vector<ofxGPoint>>::size_type i = 0; i < polygons.size(); ++i) {
+		const vector<glm::vec3>& clippedPolygon = clipPolygon(polygons[i]);
 
-			ofPopStyle();
+		if (clippedPolygon.size() > 2) {
+			polygonLine.clear();
+			polygonLine.addVertices(clippedPolygon);
+			polygonLine.close();
+			polygonTessellator.tessellateToMesh(polygonLine, OF_POLY_WINDING_ODD, polygonMesh, true);
+			polygonMesh.getColors().assign(polygonMesh.getNumVertices(), polygonColors[i % nColors]);
+			polygonsMesh.append(polygonMesh);
 		}
 	}
+
+	// Draw the mesh using the polygon colors
+	ofPushStyle();
+	ofFill();
+	ofSetColor(255);
+	polygonsMesh.draw();
+	ofPopStyle();
 }
 
 void ofxGLayer::drawAnnotation(const string& text, float x, float y, ofxGTextAlignment verAlign) const {
@@ -1189,16 +1160,16 @@ void ofxGLayer::drawAnnotation(const string& text, float x, float y, ofxGTextAli
 
 		switch (verAlign) {
 		case GRAFICA_CENTER_ALIGN:
-			font.drawString(text, xPlot, yPlot + fontSize / 2.0);
+			font->drawString(text, xPlot, yPlot + fontSize / 2.0);
 			break;
 		case GRAFICA_TOP_ALIGN:
-			font.drawString(text, xPlot, yPlot + fontSize);
+			font->drawString(text, xPlot, yPlot + fontSize);
 			break;
 		case GRAFICA_BOTTOM_ALIGN:
-			font.drawString(text, xPlot, yPlot);
+			font->drawString(text, xPlot, yPlot);
 			break;
 		default:
-			font.drawString(text, xPlot, yPlot);
+			font->drawString(text, xPlot, yPlot);
 			break;
 		}
 
@@ -1236,7 +1207,6 @@ void ofxGLayer::setXLim(float xMin, float xMax) {
 
 	xLim = {xMin, xMax};
 	updatePlotPoints();
-	updateInsideList();
 
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
@@ -1259,7 +1229,6 @@ void ofxGLayer::setYLim(float yMin, float yMax) {
 
 	yLim = {yMin, yMax};
 	updatePlotPoints();
-	updateInsideList();
 
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
@@ -1284,7 +1253,6 @@ void ofxGLayer::setXYLim(float xMin, float xMax, float yMin, float yMax) {
 	yLim = {yMin, yMax};
 
 	updatePlotPoints();
-	updateInsideList();
 
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
@@ -1312,7 +1280,6 @@ void ofxGLayer::setLimAndLogScale(float xMin, float xMax, float yMin, float yMax
 	yLim = {yMin, yMax};
 
 	updatePlotPoints();
-	updateInsideList();
 
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
@@ -1324,6 +1291,54 @@ void ofxGLayer::setLimAndLogScale(const array<float, 2>& newXLim, const array<fl
 	setLimAndLogScale(newXLim[0], newXLim[1], newYLim[0], newYLim[1], newXLogScale, newYLogScale);
 }
 
+void ofxGLayer::setDimLimAndLogScale(const array<float, 2>& newDim, const array<float, 2>& newXLim,
+		const array<float, 2>& newYLim, bool newXLogScale, bool newYLogScale) {
+	// Do nothing if the layer is already up to date
+	if (newDim == dim && newXLim == xLim && newYLim == yLim && newXLogScale == xLogScale
+			&& newYLogScale == yLogScale) {
+		return;
+	}
+
+	// Check that the new values make sense
+	if (newDim[0] <= 0 || newDim[1] <= 0) {
+		throw invalid_argument("The dimensions should be larger than zero.");
+	} else if (newXLim[0] == newXLim[1] || newYLim[0] == newYLim[1]) {
+		throw invalid_argument("The limit range cannot be zero.");
+	} else if (!isfinite(newXLim[0]) || !isfinite(newXLim[1]) || !isfinite(newYLim[0]) || !isfinite(newYLim[1])) {
+		throw invalid_argument("The limits need to be finite numbers.");
+	} else if ((newXLogScale && (newXLim[0] <= 0 || newXLim[1] <= 0))
+			|| (newYLogScale && (newYLim[0] <= 0 || newYLim[1] <= 0))) {
+		throw invalid_argument("The axis limits are negative and this is not allowed in logarithmic scale.");
+	}
+
+	bool dimChanged = newDim != dim;
+	dim = newDim;
+	xLogScale = newXLogScale;
+	yLogScale = newYLogScale;
+	xLim = newXLim;
+	yLim = newYLim;
+
+	// The plot points will be recalculated at the end of the current batch
+	if (updateDepth > 0) {
+		if (histIsActive && dimChanged) {
+			hist.setDim(dim);
+		}
+
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	updatePlotPoints();
+
+	if (histIsActive) {
+		if (dimChanged) {
+			hist.setDim(dim);
+		}
+
+		hist.setPlotPoints(plotPoints);
+	}
+}
+
 void ofxGLayer::setXLogScale(bool newXLogScale) {
 	if (newXLogScale != xLogScale) {
 		if (newXLogScale && (xLim[0] <= 0 || xLim[1] <= 0)) {
@@ -1332,7 +1347,6 @@ void ofxGLayer::setXLogScale(bool newXLogScale) {
 
 		xLogScale = newXLogScale;
 		updatePlotPoints();
-		updateInsideList();
 
 		if (histIsActive) {
 			hist.setPlotPoints(plotPoints);
@@ -1348,7 +1362,6 @@ void ofxGLayer::setYLogScale(bool newYLogScale) {
 
 		yLogScale = newYLogScale;
 		updatePlotPoints();
-		updateInsideList();
 
 		if (histIsActive) {
 			hist.setPlotPoints(plotPoints);
@@ -1357,27 +1370,96 @@ void ofxGLayer::setYLogScale(bool newYLogScale) {
 }
 
 void ofxGLayer::setPoints(const vector<ofxGPoint>& newPoints) {
-	points = newPoints;
+	points.set(newPoints);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
 	updatePlotPoints();
-	updateInsideList();
 
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
 	}
 }
 
-void ofxGLayer::setPoint(vector<ofxGPoint>::size_type index, float x, float y, const string& label) {
-	points[index].set(x, y, label);
-	plotPoints[index].set(valueToXPlot(x), valueToYPlot(y), label);
-	inside[index] = isInside(plotPoints[index]);
+void ofxGLayer::setPoints(const ofxGPointSpan& newPoints) {
+	points.setExternal(newPoints);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	updatePlotPoints();
+
+	if (histIsActive) {
+		hist.setPlotPoints(plotPoints);
+	}
+}
+
+void ofxGLayer::setPoints(const vector<float>& newXs, const vector<float>& newYs, const vector<string>& newLabels) {
+	if (newXs.size() != newYs.size()) {
+		throw invalid_argument("The coordinate vectors should have the same size.");
+	}
+
+	points.set(ofxGPointSpan(newXs.data(), newYs.data(), newXs.size()), newLabels);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	updatePlotPoints();
 
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
 	}
 }
 
+void ofxGLayer::markPointsDirty(vector<ofxGPoint>::size_type first, vector<ofxGPoint>::size_type last) {
+	if (!points.isExternal()) {
+		throw invalid_argument("The layer points are not stored in a span.");
+	} else if (first > last || last > points.size()) {
+		throw invalid_argument("The range should be inside the vector range.");
+	}
+
+	points.markDirty();
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	updatePlotPoints(first, last);
+
+	// The plot points are a view of the span, so the histogram only needs to update the sides around the range
+	if (histIsActive) {
+		hist.setPlotPoints(plotPoints, first, last);
+	}
+}
+
+void ofxGLayer::setPoint(vector<ofxGPoint>::size_type index, float x, float y, const string& label) {
+	detachPoints();
+	points.set(index, x, y, label);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	plotPoints.set(index, valueToXPlot(x), valueToYPlot(y), label);
+	plotPoints.setInside(index, isInside(plotPoints[index]));
+	invalidateCaches();
+
+	if (histIsActive) {
+		hist.setPlotPoint(index, plotPoints[index]);
+	}
+}
+
 void ofxGLayer::setPoint(vector<ofxGPoint>::size_type index, float x, float y) {
-	setPoint(index, x, y, points[index].getLabel());
+	setPoint(index, x, y, points.getLabel(index));
 }
 
 void ofxGLayer::setPoint(vector<ofxGPoint>::size_type index, const ofxGPoint& newPoint) {
@@ -1385,9 +1467,17 @@ void ofxGLayer::setPoint(vector<ofxGPoint>::size_type index, const ofxGPoint& ne
 }
 
 void ofxGLayer::addPoint(float x, float y, const string& label) {
-	points.emplace_back(x, y, label);
-	plotPoints.emplace_back(valueToXPlot(x), valueToYPlot(y), label);
-	inside.push_back(isInside(plotPoints.back()));
+	detachPoints();
+	points.push_back(x, y, label);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	plotPoints.push_back(valueToXPlot(x), valueToYPlot(y), label);
+	plotPoints.setInside(plotPoints.size() - 1, isInside(plotPoints.back()));
+	invalidateCaches();
 
 	if (histIsActive) {
 		hist.addPlotPoint(plotPoints.back());
@@ -1407,12 +1497,24 @@ void ofxGLayer::addPoint(vector<ofxGPoint>::size_type index, float x, float y, c
 		throw invalid_argument("The index should be inside the vector range.");
 	}
 
-	points.insert(points.begin() + index, ofxGPoint(x, y, label));
-	plotPoints.insert(plotPoints.begin() + index, ofxGPoint(valueToXPlot(x), valueToYPlot(y), label));
-	inside.insert(inside.begin() + index, isInside(plotPoints[index]));
+	detachPoints();
+	bool isFull = points.getCapacity() > 0 && points.size() == points.getCapacity();
+	points.insert(index, x, y, label);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	plotPoints.insert(index, valueToXPlot(x), valueToYPlot(y), label);
+
+	// A full layer removes one point to make room for the new one
+	vector<ofxGPoint>::size_type plotIndex = (isFull && index > 0) ? index - 1 : index;
+	plotPoints.setInside(plotIndex, isInside(plotPoints[plotIndex]));
+	invalidateCaches();
 
 	if (histIsActive) {
-		hist.addPlotPoint(index, plotPoints[index]);
+		hist.addPlotPoint(index, plotPoints[plotIndex]);
 	}
 }
 
@@ -1425,12 +1527,25 @@ void ofxGLayer::addPoint(vector<ofxGPoint>::size_type index, const ofxGPoint& ne
 }
 
 void ofxGLayer::addPoints(const vector<ofxGPoint>& newPoints) {
+	detachPoints();
+
+	if (updateDepth > 0) {
+		for (const ofxGPoint& p : newPoints) {
+			points.push_back(p);
+		}
+
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
 	for (const ofxGPoint& p : newPoints) {
-		points.emplace_back(p.getX(), p.getY(), p.getLabel());
-		plotPoints.emplace_back(valueToXPlot(p.getX()), valueToYPlot(p.getY()), p.getLabel());
-		inside.push_back(isInside(plotPoints.back()));
+		points.push_back(p);
+		plotPoints.push_back(valueToXPlot(p.getX()), valueToYPlot(p.getY()), p.getLabel());
+		plotPoints.setInside(plotPoints.size() - 1, isInside(plotPoints.back()));
 	}
 
+	invalidateCaches();
+
 	if (histIsActive) {
 		hist.setPlotPoints(plotPoints);
 	}
@@ -1441,21 +1556,54 @@ void ofxGLayer::removePoint(vector<ofxGPoint>::size_type index) {
 		throw invalid_argument("The index should be inside the vector range.");
 	}
 
-	points.erase(points.begin() + index);
-	plotPoints.erase(plotPoints.begin() + index);
-	inside.erase(inside.begin() + index);
+	detachPoints();
+	points.erase(index);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	plotPoints.erase(index);
+	invalidateCaches();
 
 	if (histIsActive) {
 		hist.removePlotPoint(index);
 	}
 }
 
+void ofxGLayer::setPointsCapacity(vector<ofxGPoint>::size_type capacity) {
+	points.setCapacity(capacity);
+
+	// The capacity is applied to the span points when they are copied to the layer
+	if (points.isExternal()) {
+		return;
+	}
+
+	plotPoints.setCapacity(capacity);
+
+	if (updateDepth > 0) {
+		plotPointsNeedUpdate = true;
+		return;
+	}
+
+	invalidateCaches();
+
+	if (histIsActive) {
+		hist.setPlotPoints(plotPoints);
+	}
+}
+
 void ofxGLayer::setInside(const vector<bool>& newInside) {
-	if (newInside.size() == inside.size()) {
+	if (newInside.size() != plotPoints.size()) {
 		throw invalid_argument("The vector size should match the number of points.");
 	}
 
-	inside = newInside;
+	for (vector<bool>::size_type i = 0; i < newInside.size(); ++i) {
+		plotPoints.setInside(i, newInside[i]);
+	}
+
+	invalidateCaches();
 }
 
 void ofxGLayer::setPointColors(const vector<ofColor>& newPointColors) {
@@ -1464,10 +1612,12 @@ void ofxGLayer::setPointColors(const vector<ofColor>& newPointColors) {
 	}
 
 	pointColors = newPointColors;
+	pointsMeshNeedsUpdate = true;
 }
 
 void ofxGLayer::setPointColor(const ofColor& newPointColor) {
 	pointColors = {newPointColor};
+	pointsMeshNeedsUpdate = true;
 }
 
 void ofxGLayer::setPointSizes(const vector<float>& newPointSizes) {
@@ -1476,10 +1626,14 @@ void ofxGLayer::setPointSizes(const vector<float>& newPointSizes) {
 	}
 
 	pointSizes = newPointSizes;
+	pointsMeshNeedsUpdate = true;
+	pointsGridNeedsUpdate = true;
 }
 
 void ofxGLayer::setPointSize(float newPointSize) {
 	pointSizes = {newPointSize};
+	pointsMeshNeedsUpdate = true;
+	pointsGridNeedsUpdate = true;
 }
 
 void ofxGLayer::setLineColor(const ofColor& newLineColor) {
@@ -1494,6 +1648,26 @@ void ofxGLayer::setLineWidth(float newLineWidth) {
 	lineWidth = newLineWidth;
 }
 
+void ofxGLayer::setLinesDecimation(bool decimate) {
+	if (decimate != linesDecimation) {
+		linesDecimation = decimate;
+		linesMeshNeedsUpdate = true;
+	}
+}
+
+void ofxGLayer::setDownsampling(int nPoints) {
+	if (nPoints != 0 && nPoints < 3) {
+		throw invalid_argument("The number of points should be larger than 2.");
+	}
+
+	downsamplingPoints = nPoints;
+	invalidateCaches();
+}
+
+void ofxGLayer::setDensityColors(const vector<ofColor>& colors) {
+	densityMap.setColors(colors);
+}
+
 void ofxGLayer::setHistBasePoint(const ofxGPoint& newHistBasePoint) {
 	histBasePoint = newHistBasePoint;
 }
@@ -1526,7 +1700,7 @@ void ofxGLayer::setLabelSeparation(const array<float, 2>& newLabelSeparation) {
 
 void ofxGLayer::setFontName(const string& newFontName) {
 	fontName = newFontName;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGLayer::setFontColor(const ofColor& newFontColor) {
@@ -1539,7 +1713,7 @@ void ofxGLayer::setFontSize(int newFontSize) {
 	}
 
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGLayer::setFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -1550,7 +1724,7 @@ void ofxGLayer::setFontProperties(const string& newFontName, const ofColor& newF
 	fontName = newFontName;
 	fontColor = newFontColor;
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGLayer::setAllFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -1567,7 +1741,7 @@ void ofxGLayer::setAllFontProperties(const string& newFontName, const ofColor& n
 
 void ofxGLayer::setFontsMakeContours(bool newFontMakeContours) {
 	fontMakeContours = newFontMakeContours;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 
 	if (histIsActive) {
 		hist.setFontMakeContours(fontMakeContours);
@@ -1599,10 +1773,10 @@ bool ofxGLayer::getYLogScale() const {
 }
 
 vector<ofxGPoint> ofxGLayer::getPoints() const {
-	return points;
+	return points.toVector();
 }
 
-const vector<ofxGPoint>& ofxGLayer::getPointsRef() const {
+const ofxGPointArray& ofxGLayer::getPointsRef() const {
 	return points;
 }
 
@@ -1625,3 +1799,7 @@ float ofxGLayer::getLineWidth() const {
 ofxGHistogram& ofxGLayer::getHistogram() {
 	return hist;
 }
+
+unsigned int ofxGLayer::getMeshRebuildCount() const {
+	return meshRebuildCount;
+}
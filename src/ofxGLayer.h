@@ -2,13 +2,20 @@
 
 #include "ofxGConstants.h"
 #include "ofxGPoint.h"
+#include "ofxGPointArray.h"
+#include "ofxGPointSpan.h"
+#include "ofxGPointGrid.h"
+#include "ofxGDensityMap.h"
+#include "ofxGPolygonClipper.h"
 #include "ofxGHistogram.h"
 #include "ofMain.h"
 
 /**
  * @brief Layer class
  *
- * A ofxGLayer usually contains an array of points and a histogram
+ * A ofxGLayer usually contains an array of points and a histogram. The draw methods are const, but they rebuild the
+ * cached meshes and scratch buffers stored in the layer when needed, so a layer is not thread-safe and should only be
+ * drawn from one thread at a time.
  *
  * @author Javier Graciá Carpio
  */
@@ -139,10 +146,25 @@ public:
 	 * @param xPlot x position in the plot reference system
 	 * @param yPlot y position in the plot reference system
 	 *
-	 * @return a pointer to the closest point to the specified position. Returns nullptr if there is no close point.
+	 * @return a pointer to a copy of the closest point to the specified position. Returns nullptr if there is no close
+	 * point. The pointer is only valid until the next call to this method.
 	 */
 	const ofxGPoint* getPointAtPlotPos(float xPlot, float yPlot) const;
 
+	/**
+	 * @brief Starts a batch of point modifications
+	 *
+	 * Until the matching endUpdate() call, the point setters only modify the layer points, and the plot points and
+	 * the histogram are not updated. Calls can be nested.
+	 */
+	void beginUpdate();
+
+	/**
+	 * @brief Finishes a batch of point modifications. The plot points and the histogram are recalculated once, after
+	 * the outermost batch is finished
+	 */
+	void endUpdate();
+
 	/**
 	 * @brief Initializes the histogram
 	 *
@@ -158,14 +180,14 @@ public:
 
 	/**
 	 * @brief Draws the points inside the layer limits
+	 *
+	 * All the points are drawn in a single batch, using the layer point colors and sizes
 	 */
 	void drawPoints() const;
 
 	/**
 	 * @brief Draws the points inside the layer limits
 	 *
-	 * This method is considerably faster than drawPoints()
-	 *
 	 * @param pointColor the point color
 	 */
 	void drawPoints(const ofColor& pointColor) const;
@@ -228,7 +250,7 @@ public:
 	/**
 	 * @brief Draws lines connecting consecutive points in the layer
 	 */
-	void drawLines();
+	void drawLines() const;
 
 	/**
 	 * @brief Draws a line between two points
@@ -238,7 +260,7 @@ public:
 	 * @param lc line color
 	 * @param lw line width
 	 */
-	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lc, float lw);
+	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lc, float lw) const;
 
 	/**
 	 * @brief Draws a line between two points
@@ -246,7 +268,7 @@ public:
 	 * @param point1 first point
 	 * @param point2 second point
 	 */
-	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2);
+	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2) const;
 
 	/**
 	 * @brief Draws a line defined by the slope and the cut in the y axis
@@ -256,7 +278,7 @@ public:
 	 * @param lc line color
 	 * @param lw line width
 	 */
-	void drawLine(float slope, float yCut, const ofColor& lc, float lw);
+	void drawLine(float slope, float yCut, const ofColor& lc, float lw) const;
 
 	/**
 	 * @brief Draws a line defined by the slope and the cut in the y axis
@@ -264,7 +286,7 @@ public:
 	 * @param slope the line slope
 	 * @param yCut the line y axis cut
 	 */
-	void drawLine(float slope, float yCut);
+	void drawLine(float slope, float yCut) const;
 
 	/**
 	 * @brief Draws an horizontal line
@@ -301,10 +323,12 @@ public:
 	/**
 	 * @brief Draws a filled contour connecting consecutive points in the layer and a reference value
 	 *
+	 * The contour is tessellated once and cached until the points, limits, contour type or reference value change
+	 *
 	 * @param contourType the type of contours to use. It can be GRAFICA_HORIZONTAL_CONTOUR or GRAFICA_VERTICAL_CONTOUR
 	 * @param referenceValue the reference value to use to close the contour
 	 */
-	void drawFilledContour(ofxGContourType contourType, float referenceValue);
+	void drawFilledContour(ofxGContourType contourType, float referenceValue) const;
 
 	/**
 	 * @brief Draws the label of a given point
@@ -326,6 +350,15 @@ public:
 	 */
 	void drawHistogram() const;
 
+	/**
+	 * @brief Draws the density of the points inside the plot box as an image
+	 *
+	 * The points are counted in each pixel and the counts are represented with the density colors. This is useful when
+	 * the layer has too many points to draw them individually. The image is only updated when the points, limits or
+	 * dimensions change.
+	 */
+	void drawDensity() const;
+
 	/**
 	 * @brief Draws a polygon defined by a set of points
 	 *
@@ -334,6 +367,14 @@ public:
 	 */
 	void drawPolygon(const vector<ofxGPoint>& polygonPoints, const ofColor& polygonColor);
 
+	/**
+	 * @brief Draws a set of polygons in a single batch
+	 *
+	 * @param polygons the points that define each polygon
+	 * @param polygonColors the polygon colors. They are applied cyclically to the polygons
+	 */
+	void drawPolygons(const vector<vector<ofxGPoint>>& polygons, const vector<ofColor>& polygonColors);
+
 	/**
 	 * @brief Draws an annotation at a given plot value
 	 *
@@ -430,6 +471,19 @@ public:
 	void setLimAndLogScale(const array<float, 2>& newXLim, const array<float, 2>& newYLim, bool newXLogScale,
 			bool newYLogScale);
 
+	/**
+	 * @brief Sets the plot box dimensions, the limits and the scales at once. The plot points are recalculated only
+	 * once, and only if something changed
+	 *
+	 * @param newDim the new plot box dimensions
+	 * @param newXLim the new horizontal limits
+	 * @param newYLim the new vertical limits
+	 * @param newXLogScale the new horizontal scale
+	 * @param newYLogScale the new vertical scale
+	 */
+	void setDimLimAndLogScale(const array<float, 2>& newDim, const array<float, 2>& newXLim,
+			const array<float, 2>& newYLim, bool newXLogScale, bool newYLogScale);
+
 	/**
 	 * @brief Sets the horizontal scale
 	 *
@@ -451,6 +505,36 @@ public:
 	 */
 	void setPoints(const vector<ofxGPoint>& newPoints);
 
+	/**
+	 * @brief Sets the layer points to the points stored in a span. The points are not copied
+	 *
+	 * The span memory should stay valid while the layer uses it. Call markPointsDirty when the span values change.
+	 * Modifying the layer points with setPoint, addPoint, addPoints or removePoint copies the span points to the layer
+	 * first. The points capacity is only applied after that copy.
+	 *
+	 * @param newPoints the span with the new points
+	 */
+	void setPoints(const ofxGPointSpan& newPoints);
+
+	/**
+	 * @brief Sets the layer points from their coordinate and label columns. The values are copied
+	 *
+	 * @param newXs the points x coordinates
+	 * @param newYs the points y coordinates
+	 * @param newLabels the points labels. Use an empty vector for no labels
+	 */
+	void setPoints(const vector<float>& newXs, const vector<float>& newYs, const vector<string>& newLabels = {});
+
+	/**
+	 * @brief Informs the layer that the values of some of the span points changed. The plot positions of the span
+	 * points are calculated when they are read, so only the cached meshes and the histogram elements around the
+	 * modified points are updated. Use setPoints to change the number of points
+	 *
+	 * @param first the position of the first point that changed
+	 * @param last the position after the last point that changed
+	 */
+	void markPointsDirty(vector<ofxGPoint>::size_type first, vector<ofxGPoint>::size_type last);
+
 	/**
 	 * @brief Sets one of the layer points
 	 *
@@ -543,6 +627,16 @@ public:
 	 */
 	void removePoint(vector<ofxGPoint>::size_type index);
 
+	/**
+	 * @brief Sets the maximum number of points in the layer
+	 *
+	 * When the layer is full, adding a new point removes the oldest one in constant time. This is the recommended
+	 * setting for layers that display a sliding window of streamed data.
+	 *
+	 * @param capacity the maximum number of points. Use 0 for no limit
+	 */
+	void setPointsCapacity(vector<ofxGPoint>::size_type capacity);
+
 	/**
 	 * @brief Sets which points are inside the box
 	 *
@@ -592,6 +686,36 @@ public:
 	 */
 	void setLineWidth(float newLineWidth);
 
+	/**
+	 * @brief Sets if the lines should be decimated or not
+	 *
+	 * When the decimation is active, the lines mesh only keeps the first, last, minimum and maximum vertices of each
+	 * pixel column (M4 decimation). The rasterized lines are the same, but the mesh has at most four vertices per
+	 * column. It's useful for layers sorted in x with many more points than horizontal pixels.
+	 *
+	 * @param decimate true if the lines should be decimated
+	 */
+	void setLinesDecimation(bool decimate);
+
+	/**
+	 * @brief Sets the maximum number of points that will be used to draw the layer points and lines
+	 *
+	 * The representative points are selected with the Largest-Triangle-Three-Buckets algorithm in the plot reference
+	 * system, so the result is visually close to the original data at the current limits. If the points are sorted in
+	 * x, only the visible points are considered. The selection is cached until the points or the limits change. Only
+	 * the representative points can be selected with the mouse.
+	 *
+	 * @param nPoints the maximum number of points. Use 0 to draw all the points
+	 */
+	void setDownsampling(int nPoints);
+
+	/**
+	 * @brief Sets the colors used to draw the points density
+	 *
+	 * @param colors the colormap colors, from the lowest to the highest density
+	 */
+	void setDensityColors(const vector<ofColor>& colors);
+
 	/**
 	 * @brief Sets the histogram base point
 	 *
@@ -734,7 +858,7 @@ public:
 	 *
 	 * @return the layer points
 	 */
-	const vector<ofxGPoint>& getPointsRef() const;
+	const ofxGPointArray& getPointsRef() const;
 
 	/**
 	 * @brief Returns the layer point colors array
@@ -771,101 +895,119 @@ public:
 	 */
 	ofxGHistogram& getHistogram();
 
+	/**
+	 * @brief Returns the number of times that the layer points, lines and filled contour meshes have been rebuilt
+	 *
+	 * The meshes are only rebuilt when the layer points, limits, dimensions or point sizes change, so drawing a static
+	 * frame should not increase this number.
+	 *
+	 * @return the number of mesh rebuilds
+	 */
+	unsigned int getMeshRebuildCount() const;
+
 protected:
 
 	/**
-	 * @brief Updates the position of the layer points to the plot reference system
+	 * @brief Updates the position of the layer points to the plot reference system and the bitmap that tells if the
+	 * points are inside the layer limits or not
 	 */
 	void updatePlotPoints();
 
 	/**
-	 * @brief Returns the plot x value at a given position in the plot reference system
-	 *
-	 * @param xPlot x position in the plot reference system
+	 * @brief Updates the position of a range of layer points to the plot reference system
 	 *
-	 * @return the x values at the xPlot position
+	 * @param first the position of the first point to update
+	 * @param last the position after the last point to update
 	 */
-	float xPlotToValue(float xPlot) const;
+	void updatePlotPoints(vector<ofxGPoint>::size_type first, vector<ofxGPoint>::size_type last);
 
 	/**
-	 * @brief Returns the plot y value at a given position in the plot reference system
+	 * @brief Calculates the offsets and factors that transform the layer points to the plot reference system
 	 *
-	 * @param yPlot y position in the plot reference system
-	 *
-	 * @return the y values at the yPlot position
+	 * @param offsets the x and y offsets
+	 * @param factors the x and y scaling factors
 	 */
-	float yPlotToValue(float yPlot) const;
+	void calculatePlotTransformation(array<float, 2>& offsets, array<float, 2>& factors) const;
 
 	/**
-	 * @brief Updates the array list that tells if the points are inside the layer limits or not
+	 * @brief Copies the span points to the layer, so they can be modified
 	 */
-	void updateInsideList();
+	void detachPoints();
 
 	/**
-	 * @brief Obtains the box intersections of the line that connects two given points
-	 *
-	 * @param plotPoint1 the first point in the plot reference system
-	 * @param plotPoint2 the second point in the plot reference system
+	 * @brief Marks the cached meshes, points grid, representative points and density map of the layer as outdated
+	 */
+	void invalidateCaches();
+
+	/**
+	 * @brief Returns the positions of the representative points if the downsampling is active
 	 *
-	 * @return the number of box intersections in the plot reference system
+	 * @return the positions of the representative points. Null if the downsampling is not active
 	 */
-	int obtainBoxIntersections(const ofxGPoint& plotPoint1, const ofxGPoint& plotPoint2);
+	const vector<ofxGPointArray::size_type>* getSampledIndices() const;
 
 	/**
-	 * @brief Returns only those cuts that are inside the box region and lie between the two given points
+	 * @brief Selects the representative points using the Largest-Triangle-Three-Buckets algorithm
+	 */
+	void updateSampledIndices() const;
+
+	/**
+	 * @brief Transforms a polygon to the plot reference system and clips it with the plot box
 	 *
-	 * @param cuts the axis cuts
-	 * @param nCuts the number of cuts
-	 * @param plotPoint1 the first point in the plot reference system
-	 * @param plotPoint2 the second point in the plot reference system
+	 * @param polygonPoints the points that define the polygon. The invalid points are ignored
 	 *
-	 * @return the number of cuts inside the box region and between the two points
+	 * @return the vertices of the clipped polygon. They are only valid until the next call to this method
 	 */
-	int getValidCuts(array<array<float, 2>, 4>& cuts, int nCuts, const ofxGPoint& plotPoint1,
-			const ofxGPoint& plotPoint2);
+	const vector<glm::vec3>& clipPolygon(const vector<ofxGPoint>& polygonPoints);
 
 	/**
-	 * @brief Removes duplicated cuts
+	 * @brief Rebuilds the points mesh
 	 *
-	 * @param cuts the box cuts
-	 * @param nCuts the number of cuts
-	 * @param tolerance maximum distance after which the points can't be duplicates
+	 * @param circleResolution the number of vertices used to draw each point circle
+	 * @param withColors true if the mesh should contain the point colors
+	 */
+	void updatePointsMesh(int circleResolution, bool withColors) const;
+
+	/**
+	 * @brief Rebuilds the lines mesh
+	 */
+	void updateLinesMesh() const;
+
+	/**
+	 * @brief Rebuilds the filled contour mesh
 	 *
-	 * @return the number of cuts without the duplications
+	 * @param contourType the type of contours to use. It can be GRAFICA_HORIZONTAL_CONTOUR or GRAFICA_VERTICAL_CONTOUR
+	 * @param referenceValue the reference value to use to close the contour
 	 */
-	int removeDuplicatedCuts(array<array<float, 2>, 4>& cuts, int nCuts, float tolerance);
+	void updateContourMesh(ofxGContourType contourType, float referenceValue) const;
 
 	/**
-	 * @brief Removes cuts that are equal to a given point
+	 * @brief Returns the plot x value at a given position in the plot reference system
 	 *
-	 * @param cuts the box cuts
-	 * @param nCuts the number of cuts
-	 * @param plotPoint the point to compare with
-	 * @param tolerance maximum distance after which the points can't be equal
+	 * @param xPlot x position in the plot reference system
 	 *
-	 * @return the number of cuts without the point duplications
+	 * @return the x values at the xPlot position
 	 */
-	int removePointFromCuts(array<array<float, 2>, 4>& cuts, int nCuts, const ofxGPoint& plotPoint, float tolerance);
+	float xPlotToValue(float xPlot) const;
 
 	/**
-	 * @brief Obtains the shape points of the horizontal contour that connects consecutive layer points and a reference
-	 * value
+	 * @brief Returns the plot y value at a given position in the plot reference system
 	 *
-	 * @param referenceValue the reference value to use to close the contour
+	 * @param yPlot y position in the plot reference system
 	 *
-	 * @return the shape points
+	 * @return the y values at the yPlot position
 	 */
-	vector<ofxGPoint> getHorizontalShape(float referenceValue);
+	float yPlotToValue(float yPlot) const;
 
 	/**
-	 * @brief Obtains the shape points of the vertical contour that connects consecutive layer points and a reference
-	 * value
+	 * @brief Obtains the shape points of the contour that connects consecutive layer points and a reference value
 	 *
+	 * @param contourType the contour type: GRAFICA_HORIZONTAL_CONTOUR or GRAFICA_VERTICAL_CONTOUR
 	 * @param referenceValue the reference value to use to close the contour
 	 *
 	 * @return the shape points
 	 */
-	vector<ofxGPoint> getVerticalShape(float referenceValue);
+	vector<glm::vec2> getContourShape(ofxGContourType contourType, float referenceValue) const;
 
 	/**
 	 * @brief The layer id
@@ -900,17 +1042,17 @@ protected:
 	/**
 	 * @brief The layer points
 	 */
-	vector<ofxGPoint> points;
+	ofxGPointArray points;
 
 	/**
-	 * @brief The layer points in the plot reference system
+	 * @brief The layer points in the plot reference system. It also stores if the points are inside the layer limits
 	 */
-	vector<ofxGPoint> plotPoints;
+	ofxGPointArray plotPoints;
 
 	/**
-	 * @brief Defines if the points are inside the layer limits
+	 * @brief Copy of the last point returned by getPointAtPlotPos
 	 */
-	vector<bool> inside;
+	mutable ofxGPoint selectedPoint;
 
 	/**
 	 * @brief The points colors
@@ -947,6 +1089,16 @@ protected:
 	 */
 	bool histIsActive;
 
+	/**
+	 * @brief The number of nested point modification batches in progress
+	 */
+	int updateDepth;
+
+	/**
+	 * @brief Defines if the plot points should be recalculated when the point modification batch finishes
+	 */
+	bool plotPointsNeedUpdate;
+
 	/**
 	 * @brief The label background color
 	 */
@@ -978,12 +1130,134 @@ protected:
 	bool fontMakeContours;
 
 	/**
-	 * @brief The trueType font
+	 * @brief The trueType font. It is shared with the other plot components that use the same font properties
+	 */
+	shared_ptr<ofTrueTypeFont> font;
+
+	/**
+	 * @brief The mesh used to draw the points. It's stored in the GPU, so it's only uploaded after a rebuild
+	 */
+	mutable ofVboMesh pointsMesh;
+
+	/**
+	 * @brief Defines if the points mesh should be rebuilt before drawing it
+	 */
+	mutable bool pointsMeshNeedsUpdate;
+
+	/**
+	 * @brief The circle resolution used to build the points mesh
+	 */
+	mutable int pointsMeshCircleResolution;
+
+	/**
+	 * @brief Defines if the points mesh contains the point colors. They are only needed if the points have different
+	 * colors
+	 */
+	mutable bool pointsMeshHasColors;
+
+	/**
+	 * @brief The mesh used to draw the lines connecting the points. It's stored in the GPU, so it's only uploaded after
+	 * a rebuild
+	 */
+	mutable ofVboMesh linesMesh;
+
+	/**
+	 * @brief Defines if the lines mesh should be rebuilt before drawing it
+	 */
+	mutable bool linesMeshNeedsUpdate;
+
+	/**
+	 * @brief Defines if the lines mesh should be decimated
+	 */
+	bool linesDecimation;
+
+	/**
+	 * @brief The number of times that the layer meshes have been rebuilt
+	 */
+	mutable unsigned int meshRebuildCount;
+
+	/**
+	 * @brief The spatial index used to find the points close to a given position
+	 */
+	mutable ofxGPointGrid pointsGrid;
+
+	/**
+	 * @brief Defines if the points grid should be rebuilt before using it
+	 */
+	mutable bool pointsGridNeedsUpdate;
+
+	/**
+	 * @brief The maximum number of points used to draw the layer. 0 means no downsampling
+	 */
+	ofxGPointArray::size_type downsamplingPoints;
+
+	/**
+	 * @brief The positions of the representative points used when the downsampling is active
+	 */
+	mutable vector<ofxGPointArray::size_type> sampledIndices;
+
+	/**
+	 * @brief Defines if the representative points should be selected again before using them
+	 */
+	mutable bool sampledIndicesNeedUpdate;
+
+	/**
+	 * @brief The points density map
+	 */
+	mutable ofxGDensityMap densityMap;
+
+	/**
+	 * @brief Defines if the density map should be updated before drawing it
+	 */
+	mutable bool densityMapNeedsUpdate;
+
+	/**
+	 * @brief The polygon clipper. It keeps the clipping buffers between calls
+	 */
+	ofxGPolygonClipper polygonClipper;
+
+	/**
+	 * @brief Buffer with the polygon vertices in the plot reference system
+	 */
+	vector<glm::vec3> polygonVertices;
+
+	/**
+	 * @brief Buffer with the polygon outline used for tessellation
+	 */
+	ofPolyline polygonLine;
+
+	/**
+	 * @brief The tessellator used to draw a set of polygons
+	 */
+	ofTessellator polygonTessellator;
+
+	/**
+	 * @brief Buffer with the tessellated polygon
+	 */
+	ofMesh polygonMesh;
+
+	/**
+	 * @brief The mesh used to draw a set of polygons
+	 */
+	ofMesh polygonsMesh;
+
+	/**
+	 * @brief The tessellated filled contour
+	 */
+	mutable ofMesh contourMesh;
+
+	/**
+	 * @brief Defines if the filled contour mesh should be rebuilt before drawing it
+	 */
+	mutable bool contourMeshNeedsUpdate;
+
+	/**
+	 * @brief The contour type used to build the filled contour mesh
 	 */
-	ofTrueTypeFont font;
+	mutable ofxGContourType contourMeshType;
 
 	/**
-	 * @brief Utility array containing line cuts with the plot box
+	 * @brief The reference value used to build the filled contour mesh
 	 */
-	array<array<float, 2>, 4> cuts;
+	mutable float contourMeshReferenceValue;
 };
@@ -0,0 +1,101 @@
+#include "ofxGLimitsTracker.h"
+#include "ofMain.h"
+
+ofxGLimitsTracker::ofxGLimitsTracker() :
+		slidingWindow(false), minValue(numeric_limits<float>::infinity()),
+		maxValue(-numeric_limits<float>::infinity()), positiveMinValue(numeric_limits<float>::infinity()),
+		firstIndex(0), nextIndex(0) {
+}
+
+void ofxGLimitsTracker::clear() {
+	minValue = numeric_limits<float>::infinity();
+	maxValue = -numeric_limits<float>::infinity();
+	positiveMinValue = numeric_limits<float>::infinity();
+	minQueue.clear();
+	maxQueue.clear();
+	positiveMinQueue.clear();
+	firstIndex = 0;
+	nextIndex = 0;
+}
+
+void ofxGLimitsTracker::setSlidingWindow(bool newSlidingWindow) {
+	slidingWindow = newSlidingWindow;
+	clear();
+}
+
+bool ofxGLimitsTracker::isSlidingWindow() const {
+	return slidingWindow;
+}
+
+void ofxGLimitsTracker::push_back(float value, bool valid) {
+	if (!valid) {
+		++nextIndex;
+		return;
+	}
+
+	if (!slidingWindow) {
+		minValue = min(minValue, value);
+		maxValue = max(maxValue, value);
+
+		if (value > 0) {
+			positiveMinValue = min(positiveMinValue, value);
+		}
+	} else {
+		pushToQueue(minQueue, value, true);
+		pushToQueue(maxQueue, value, false);
+
+		if (value > 0) {
+			pushToQueue(positiveMinQueue, value, true);
+		}
+	}
+
+	++nextIndex;
+}
+
+void ofxGLimitsTracker::pop_front() {
+	// Remove the first value from the queues if it's still there
+	if (!minQueue.empty() && minQueue.front().first == firstIndex) {
+		minQueue.pop_front();
+	}
+
+	if (!maxQueue.empty() && maxQueue.front().first == firstIndex) {
+		maxQueue.pop_front();
+	}
+
+	if (!positiveMinQueue.empty() && positiveMinQueue.front().first == firstIndex) {
+		positiveMinQueue.pop_front();
+	}
+
+	++firstIndex;
+}
+
+array<float, 2> ofxGLimitsTracker::getLim(bool positiveOnly) const {
+	if (!slidingWindow) {
+		if (!positiveOnly || positiveMinValue <= maxValue) {
+			return {positiveOnly ? positiveMinValue : minValue, maxValue};
+		}
+	} else if (positiveOnly) {
+		// The maximum is positive if there is at least one positive value
+		if (!positiveMinQueue.empty()) {
+			return {positiveMinQueue.front().second, maxQueue.front().second};
+		}
+	} else if (!minQueue.empty()) {
+		return {minQueue.front().second, maxQueue.front().second};
+	}
+
+	return {numeric_limits<float>::infinity(), -numeric_limits<float>::infinity()};
+}
+
+void ofxGLimitsTracker::pushToQueue(deque<pair<uint64_t, float>>& queue, float value, bool keepSmaller) {
+	if (keepSmaller) {
+		while (!queue.empty() && queue.back().second >= value) {
+			queue.pop_back();
+		}
+	} else {
+		while (!queue.empty() && queue.back().second <= value) {
+			queue.pop_back();
+		}
+	}
+
+	queue.emplace_back(nextIndex, value);
+}
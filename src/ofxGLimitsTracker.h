@@ -0,0 +1,122 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ * @brief Limits tracker class
+ *
+ * An ofxGLimitsTracker keeps the minimum and maximum of a sequence of values. The minimum of the positive values is
+ * also tracked, to be used with logarithmic scales.
+ *
+ * By default the tracker only keeps the current limits, so values can be added at the end but not removed. In sliding
+ * window mode, the sequence can also shrink at the beginning. The tracker then uses monotonic queues, so adding or
+ * removing a value costs constant amortized time. The queues can hold as many values as the window (for example with
+ * monotonic data), so this mode should only be used when the window size is bounded.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGLimitsTracker {
+public:
+
+	/**
+	 * @brief Constructor
+	 */
+	ofxGLimitsTracker();
+
+	/**
+	 * @brief Removes all the values from the tracker
+	 */
+	void clear();
+
+	/**
+	 * @brief Activates or deactivates the sliding window mode. It removes all the values from the tracker
+	 *
+	 * @param newSlidingWindow true if values will be removed from the beginning of the sequence
+	 */
+	void setSlidingWindow(bool newSlidingWindow);
+
+	/**
+	 * @brief Checks if the tracker is in sliding window mode
+	 *
+	 * @return true if the tracker is in sliding window mode
+	 */
+	bool isSlidingWindow() const;
+
+	/**
+	 * @brief Adds a value at the end of the sequence
+	 *
+	 * @param value the value to add
+	 * @param valid false if the value should not be used in the limits calculation
+	 */
+	void push_back(float value, bool valid);
+
+	/**
+	 * @brief Removes the first value of the sequence. It should only be used in sliding window mode
+	 */
+	void pop_front();
+
+	/**
+	 * @brief Returns the minimum and maximum values of the sequence
+	 *
+	 * @param positiveOnly true if only the positive values should be considered
+	 *
+	 * @return the minimum and maximum values. It will return {infinity, -infinity} if there are no valid values
+	 */
+	array<float, 2> getLim(bool positiveOnly) const;
+
+protected:
+
+	/**
+	 * @brief Adds a value to the end of a monotonic queue, removing the values that can't be an extreme anymore
+	 *
+	 * @param queue the monotonic queue
+	 * @param value the value to add
+	 * @param keepSmaller true for a minimum queue, false for a maximum queue
+	 */
+	void pushToQueue(deque<pair<uint64_t, float>>& queue, float value, bool keepSmaller);
+
+	/**
+	 * @brief Defines if the tracker is in sliding window mode
+	 */
+	bool slidingWindow;
+
+	/**
+	 * @brief The minimum value, if the tracker is not in sliding window mode
+	 */
+	float minValue;
+
+	/**
+	 * @brief The maximum value, if the tracker is not in sliding window mode
+	 */
+	float maxValue;
+
+	/**
+	 * @brief The minimum positive value, if the tracker is not in sliding window mode
+	 */
+	float positiveMinValue;
+
+	/**
+	 * @brief Queue with the candidates to be the minimum value
+	 */
+	deque<pair<uint64_t, float>> minQueue;
+
+	/**
+	 * @brief Queue with the candidates to be the maximum value
+	 */
+	deque<pair<uint64_t, float>> maxQueue;
+
+	/**
+	 * @brief Queue with the candidates to be the minimum positive value
+	 */
+	deque<pair<uint64_t, float>> positiveMinQueue;
+
+	/**
+	 * @brief The sequence number of the first value
+	 */
+	uint64_t firstIndex;
+
+	/**
+	 * @brief The sequence number that the next value will have
+	 */
+	uint64_t nextIndex;
+};
@@ -0,0 +1,76 @@
+#include "ofxGLineClipper.h"
+#include "ofMain.h"
+
+ofxGLineClipper::ofxGLineClipper(const array<float, 2>& _dim) :
+		dim(_dim) {
+}
+
+void ofxGLineClipper::clip(const float* x1, const float* y1, const float* x2, const float* y2, size_t n, float* t0,
+		float* t1) const {
+	float xMax = dim[0];
+	float yMin = -dim[1];
+
+	for (size_t i = 0; i < n; ++i) {
+		float deltaX = x2[i] - x1[i];
+		float deltaY = y2[i] - y1[i];
+
+		// The four box borders, written as p * t <= q
+		float p[4] = { -deltaX, deltaX, -deltaY, deltaY };
+		float q[4] = { x1[i], xMax - x1[i], y1[i] - yMin, -y1[i] };
+		float tMin = 0;
+		float tMax = 1;
+
+		for (int k = 0; k < 4; ++k) {
+			float r = q[k] / (p[k] != 0 ? p[k] : 1);
+			tMin = (p[k] < 0) ? max(tMin, r) : tMin;
+			tMax = (p[k] > 0) ? min(tMax, r) : tMax;
+
+			// Segments parallel to the border and outside the box are not visible
+			tMin = (p[k] == 0 && q[k] < 0) ? 2 : tMin;
+		}
+
+		t0[i] = tMin;
+		t1[i] = tMax;
+	}
+}
+
+int ofxGLineClipper::getCuts(float x1, float y1, float x2, float y2, array<array<float, 2>, 2>& cuts) const {
+	float t0;
+	float t1;
+	clip(&x1, &y1, &x2, &y2, 1, &t0, &t1);
+	int nCuts = 0;
+
+	if (t0 <= t1) {
+		if (t0 > 0) {
+			cuts[nCuts] = getBorderPoint(x1, y1, x2, y2, t0);
+			++nCuts;
+		}
+
+		if (t1 < 1) {
+			cuts[nCuts] = getBorderPoint(x1, y1, x2, y2, t1);
+			++nCuts;
+		}
+	}
+
+	return nCuts;
+}
+
+array<float, 2> ofxGLineClipper::getBorderPoint(float x1, float y1, float x2, float y2, float t) const {
+	float x = ofClamp(x1 + t * (x2 - x1), 0, dim[0]);
+	float y = ofClamp(y1 + t * (y2 - y1), -dim[1], 0);
+
+	// Remove the rounding errors moving the point to the closest border
+	array<float, 4> distances = { x, dim[0] - x, y + dim[1], -y };
+	int closestBorder = min_element(distances.begin(), distances.end()) - distances.begin();
+
+	switch (closestBorder) {
+	case 0:
+		return {0, y};
+	case 1:
+		return {dim[0], y};
+	case 2:
+		return {x, -dim[1]};
+	default:
+		return {x, 0};
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ * @brief Line clipper class
+ *
+ * An ofxGLineClipper clips line segments against the plot box using the Liang–Barsky algorithm. It doesn't store any
+ * intermediate result, so the same clipper can be used from several threads. The batch method processes the segments
+ * in a branch-free loop that the compiler can vectorize.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGLineClipper {
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param _dim the plot box dimensions. The box goes from 0 to dim[0] in x and from -dim[1] to 0 in y
+	 */
+	ofxGLineClipper(const array<float, 2>& _dim);
+
+	/**
+	 * @brief Clips a set of segments against the plot box
+	 *
+	 * The visible part of each segment goes from start + t0 * (end - start) to start + t1 * (end - start). The segment
+	 * is completely outside the box if t0 is larger than t1.
+	 *
+	 * @param x1 the segments start x coordinates
+	 * @param y1 the segments start y coordinates
+	 * @param x2 the segments end x coordinates
+	 * @param y2 the segments end y coordinates
+	 * @param n the number of segments
+	 * @param t0 the array where the start parameters of the visible parts will be saved
+	 * @param t1 the array where the end parameters of the visible parts will be saved
+	 */
+	void clip(const float* x1, const float* y1, const float* x2, const float* y2, size_t n, float* t0,
+			float* t1) const;
+
+	/**
+	 * @brief Calculates the intersections of a segment with the plot box borders
+	 *
+	 * @param x1 the segment start x coordinate
+	 * @param y1 the segment start y coordinate
+	 * @param x2 the segment end x coordinate
+	 * @param y2 the segment end y coordinate
+	 * @param cuts the array where the intersections will be saved, ordered from the segment start
+	 *
+	 * @return the number of intersections. It will be 0 if both points are inside the box or the segment doesn't cross
+	 * the box, 1 if only one of the points is inside the box, and 2 if the segment crosses the box
+	 */
+	int getCuts(float x1, float y1, float x2, float y2, array<array<float, 2>, 2>& cuts) const;
+
+	/**
+	 * @brief Returns the segment position at a given parameter, moved to the closest box border
+	 *
+	 * @param x1 the segment start x coordinate
+	 * @param y1 the segment start y coordinate
+	 * @param x2 the segment end x coordinate
+	 * @param y2 the segment end y coordinate
+	 * @param t the segment parameter
+	 *
+	 * @return the position on the box border
+	 */
+	array<float, 2> getBorderPoint(float x1, float y1, float x2, float y2, float t) const;
+
+protected:
+
+	/**
+	 * @brief The plot box dimensions
+	 */
+	array<float, 2> dim;
+};
@@ -0,0 +1,80 @@
+#include "ofxGLineDecimator.h"
+#include "ofMain.h"
+
+ofxGLineDecimator::ofxGLineDecimator(vector<glm::vec3>& _vertices) :
+		vertices(_vertices), polylineStarted(false), hasWrittenVertex(false), column(0), counter(0) {
+}
+
+void ofxGLineDecimator::addSegment(const glm::vec3& start, const glm::vec3& end) {
+	// Start a new polyline if the segment is not connected with the previous one
+	if (!polylineStarted || start != lastEnd) {
+		flush();
+		polylineStarted = true;
+		addVertex(start);
+	}
+
+	addVertex(end);
+	lastEnd = end;
+}
+
+void ofxGLineDecimator::flush() {
+	if (polylineStarted) {
+		flushColumn();
+		polylineStarted = false;
+		hasWrittenVertex = false;
+		counter = 0;
+	}
+}
+
+void ofxGLineDecimator::addVertex(const glm::vec3& vertex) {
+	float vertexColumn = floor(vertex.x);
+
+	if (counter == 0 || vertexColumn != column) {
+		// Start a new pixel column
+		if (counter > 0) {
+			flushColumn();
+		}
+
+		column = vertexColumn;
+		columnVertices.fill(vertex);
+		columnOrder.fill(counter);
+	} else {
+		if (vertex.y < columnVertices[1].y) {
+			columnVertices[1] = vertex;
+			columnOrder[1] = counter;
+		}
+
+		if (vertex.y > columnVertices[2].y) {
+			columnVertices[2] = vertex;
+			columnOrder[2] = counter;
+		}
+
+		columnVertices[3] = vertex;
+		columnOrder[3] = counter;
+	}
+
+	++counter;
+}
+
+void ofxGLineDecimator::flushColumn() {
+	// Write the vertices in the polyline order, skipping the repeated ones
+	if (columnOrder[1] > columnOrder[2]) {
+		swap(columnVertices[1], columnVertices[2]);
+		swap(columnOrder[1], columnOrder[2]);
+	}
+
+	int lastOrder = -1;
+
+	for (int i = 0; i < 4; ++i) {
+		if (columnOrder[i] > lastOrder) {
+			if (hasWrittenVertex) {
+				vertices.push_back(lastWrittenVertex);
+				vertices.push_back(columnVertices[i]);
+			}
+
+			lastWrittenVertex = columnVertices[i];
+			hasWrittenVertex = true;
+			lastOrder = columnOrder[i];
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ * @brief Line decimator class
+ *
+ * An ofxGLineDecimator receives the segments of a set of polylines and writes a reduced version of them, where only the
+ * first, last, minimum and maximum vertices of each pixel column are kept (M4 decimation). The rasterized lines are the
+ * same, but there are at most four vertices per pixel column. The reduction is done on the fly, without storing the
+ * original segments.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGLineDecimator {
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param _vertices the vertices array where the decimated segments will be added, two vertices per segment
+	 */
+	ofxGLineDecimator(vector<glm::vec3>& _vertices);
+
+	/**
+	 * @brief Adds a segment. Consecutive segments that share a vertex are considered part of the same polyline
+	 *
+	 * @param start the segment start vertex
+	 * @param end the segment end vertex
+	 */
+	void addSegment(const glm::vec3& start, const glm::vec3& end);
+
+	/**
+	 * @brief Writes the decimated segments that are still pending. It should be called after the last segment
+	 */
+	void flush();
+
+protected:
+
+	/**
+	 * @brief Adds a vertex to the current polyline
+	 *
+	 * @param vertex the vertex to add
+	 */
+	void addVertex(const glm::vec3& vertex);
+
+	/**
+	 * @brief Writes the selected vertices of the current pixel column
+	 */
+	void flushColumn();
+
+	/**
+	 * @brief The vertices array where the decimated segments are added
+	 */
+	vector<glm::vec3>& vertices;
+
+	/**
+	 * @brief Defines if there is a polyline in progress
+	 */
+	bool polylineStarted;
+
+	/**
+	 * @brief The end vertex of the last segment
+	 */
+	glm::vec3 lastEnd;
+
+	/**
+	 * @brief Defines if a vertex of the current polyline has been written
+	 */
+	bool hasWrittenVertex;
+
+	/**
+	 * @brief The last vertex of the current polyline that has been written
+	 */
+	glm::vec3 lastWrittenVertex;
+
+	/**
+	 * @brief The current pixel column
+	 */
+	float column;
+
+	/**
+	 * @brief The first, minimum, maximum and last vertices of the current pixel column
+	 */
+	array<glm::vec3, 4> columnVertices;
+
+	/**
+	 * @brief The order of the first, minimum, maximum and last vertices in the polyline
+	 */
+	array<int, 4> columnOrder;
+
+	/**
+	 * @brief The number of vertices added to the current polyline
+	 */
+	int counter;
+};
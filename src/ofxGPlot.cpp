@@ -1,5 +1,7 @@
 #include "ofxGPlot.h"
 #include "ofxGConstants.h"
+#include "ofxGPointArray.h"
+#include "ofxGPointSpan.h"
 #include "ofxGLayer.h"
 #include "ofxGAxis.h"
 #include "ofxGTitle.h"
@@ -40,6 +42,15 @@ ofxGPlot::ofxGPlot(float xPos, float yPos, float plotWidth, float plotHeight) :
 	rightAxis = ofxGAxis(GRAFICA_RIGHT_AXIS, dim, yLim, yLogScale);
 	title = ofxGTitle(dim);
 
+	// Pending updates. The components start in sync with the plot
+	limitsNeedUpdate = false;
+	dimNeedsUpdate = false;
+	xAxesNeedUpdate = false;
+	yAxesNeedUpdate = false;
+	layersNeedUpdate = false;
+	updateDepth = 0;
+	layersUpdateDeferred = false;
+
 	// Mouse events
 	zoomingIsActive = false;
 	zoomFactor = 1.3;
@@ -103,8 +114,15 @@ void ofxGPlot::addLayer(const ofxGLayer& newLayer) {
 	// Add the layer to the list
 	if (!sameId) {
 		layerList.push_back(newLayer);
-		layerList.back().setDim(dim);
-		layerList.back().setLimAndLogScale(xLim, yLim, xLogScale, yLogScale);
+		layersNeedUpdate = true;
+
+		for (int i = 0; i < updateDepth; ++i) {
+			layerList.back().beginUpdate();
+		}
+
+		if (layersUpdateDeferred) {
+			layerList.back().beginUpdate();
+		}
 
 		// Calculate and update the new plot limits if necessary
 		if (includeAllLayersInLim) {
@@ -133,6 +151,19 @@ void ofxGPlot::addLayer(const string& id, const vector<ofxGPoint>& points) {
 	// Add the layer to the list
 	if (!sameId) {
 		layerList.emplace_back(id, dim, xLim, yLim, xLogScale, yLogScale);
+		layersNeedUpdate = true;
+
+		for (int i = 0; i < updateDepth; ++i) {
+			layerList.back().beginUpdate();
+		}
+
+		// The layer plot points are calculated at the next update, with the new plot limits
+		if (layersUpdateDeferred) {
+			layerList.back().beginUpdate();
+		} else {
+			deferLayersUpdate();
+		}
+
 		layerList.back().setPoints(points);
 
 		// Calculate and update the new plot limits if necessary
@@ -174,10 +205,9 @@ array<float, 2> ofxGPlot::getPlotPosAt(float xScreen, float yScreen) const {
 }
 
 array<float, 2> ofxGPlot::getScreenPosAtValue(float xValue, float yValue) const {
-	float xScreen = mainLayer.valueToXPlot(xValue) + (pos[0] + mar[1]);
-	float yScreen = mainLayer.valueToYPlot(yValue) + (pos[1] + mar[2] + dim[1]);
+	array<float, 2> plotPos = valueToPlot(xValue, yValue);
 
-	return {xScreen, yScreen};
+	return {plotPos[0] + (pos[0] + mar[1]), plotPos[1] + (pos[1] + mar[2] + dim[1])};
 }
 
 const ofxGPoint* ofxGPlot::getPointAt(float xScreen, float yScreen) const {
@@ -204,6 +234,18 @@ const ofxGPoint* ofxGPlot::getPointAt(float xScreen, float yScreen, const string
 	return p;
 }
 
+const ofxGPoint* ofxGPlot::getPointAt(float xScreen, float yScreen) {
+	update();
+
+	return static_cast<const ofxGPlot&>(*this).getPointAt(xScreen, yScreen);
+}
+
+const ofxGPoint* ofxGPlot::getPointAt(float xScreen, float yScreen, const string& layerId) {
+	update();
+
+	return static_cast<const ofxGPlot&>(*this).getPointAt(xScreen, yScreen, layerId);
+}
+
 void ofxGPlot::addPointAt(float xScreen, float yScreen) {
 	array<float, 2> value = getValueAt(xScreen, yScreen);
 	addPoint(value[0], value[1]);
@@ -215,6 +257,8 @@ void ofxGPlot::addPointAt(float xScreen, float yScreen, const string& layerId) {
 }
 
 void ofxGPlot::removePointAt(float xScreen, float yScreen) {
+	update();
+
 	array<float, 2> plotPos = getPlotPosAt(xScreen, yScreen);
 	vector<ofxGPoint>::size_type pointIndex = mainLayer.getPointIndexAtPlotPos(plotPos[0], plotPos[1]);
 
@@ -224,8 +268,10 @@ void ofxGPlot::removePointAt(float xScreen, float yScreen) {
 }
 
 void ofxGPlot::removePointAt(float xScreen, float yScreen, const string& layerId) {
+	update();
+
 	array<float, 2> plotPos = getPlotPosAt(xScreen, yScreen);
-	vector<ofxGPoint>::size_type pointIndex = getLayer(layerId).getPointIndexAtPlotPos(plotPos[0], plotPos[1]);
+	vector<ofxGPoint>::size_type pointIndex = findLayer(layerId).getPointIndexAtPlotPos(plotPos[0], plotPos[1]);
 
 	if (pointIndex >= 0) {
 		removePoint(pointIndex, layerId);
@@ -235,7 +281,7 @@ void ofxGPlot::removePointAt(float xScreen, float yScreen, const string& layerId
 array<float, 2> ofxGPlot::getValueAt(float xScreen, float yScreen) const {
 	array<float, 2> plotPos = getPlotPosAt(xScreen, yScreen);
 
-	return mainLayer.plotToValue(plotPos[0], plotPos[1]);
+	return plotToValue(plotPos[0], plotPos[1]);
 }
 
 array<float, 2> ofxGPlot::getRelativePlotPosAt(float xScreen, float yScreen) const {
@@ -255,34 +301,144 @@ bool ofxGPlot::isOverBox(float xScreen, float yScreen) const {
 }
 
 void ofxGPlot::updateLimits() {
-	// Calculate the new limits and update the axes if needed
-	if (!fixedXLim) {
-		xLim = calculatePlotXLim();
-		xAxis.setLim(xLim);
-		topAxis.setLim(xLim);
+	limitsNeedUpdate = true;
+}
+
+void ofxGPlot::update() {
+	// Calculate the new limits if needed
+	updateLim();
+
+	// Update the axes and the title
+	if (dimNeedsUpdate) {
+		xAxis.setDim(dim);
+		topAxis.setDim(dim);
+		yAxis.setDim(dim);
+		rightAxis.setDim(dim);
+		title.setDim(dim);
+		dimNeedsUpdate = false;
+		layersNeedUpdate = true;
 	}
 
-	if (!fixedYLim) {
-		yLim = calculatePlotYLim();
-		yAxis.setLim(yLim);
-		rightAxis.setLim(yLim);
+	if (xAxesNeedUpdate) {
+		xAxis.setLimAndLogScale(xLim, xLogScale);
+		topAxis.setLimAndLogScale(xLim, xLogScale);
+		xAxesNeedUpdate = false;
+	}
+
+	if (yAxesNeedUpdate) {
+		yAxis.setLimAndLogScale(yLim, yLogScale);
+		rightAxis.setLimAndLogScale(yLim, yLogScale);
+		yAxesNeedUpdate = false;
+	}
+
+	// Update the layers. Each layer recalculates its plot points only once
+	if (layersNeedUpdate) {
+		mainLayer.setDimLimAndLogScale(dim, xLim, yLim, xLogScale, yLogScale);
+
+		for (ofxGLayer& layer : layerList) {
+			layer.setDimLimAndLogScale(dim, xLim, yLim, xLogScale, yLogScale);
+		}
+
+		layersNeedUpdate = false;
+	}
+
+	// Finish the layers batch, now that they have the new limits
+	if (layersUpdateDeferred) {
+		layersUpdateDeferred = false;
+		mainLayer.endUpdate();
+
+		for (ofxGLayer& layer : layerList) {
+			layer.endUpdate();
+		}
+	}
+}
+
+void ofxGPlot::updateLim() const {
+	if (limitsNeedUpdate) {
+		if (!fixedXLim) {
+			xLim = calculatePlotXLim();
+			xAxesNeedUpdate = true;
+		}
+
+		if (!fixedYLim) {
+			yLim = calculatePlotYLim();
+			yAxesNeedUpdate = true;
+		}
+
+		limitsNeedUpdate = false;
+		layersNeedUpdate = true;
 	}
+}
 
-	// Update the layers
-	mainLayer.setXYLim(xLim, yLim);
+void ofxGPlot::deferLayersUpdate() {
+	if (!layersUpdateDeferred) {
+		layersUpdateDeferred = true;
+		mainLayer.beginUpdate();
+
+		for (ofxGLayer& layer : layerList) {
+			layer.beginUpdate();
+		}
+	}
+}
+
+array<float, 2> ofxGPlot::valueToPlot(float xValue, float yValue) const {
+	updateLim();
+
+	float xPlot = xLogScale ? dim[0] * log10(xValue / xLim[0]) / log10(xLim[1] / xLim[0]) :
+			dim[0] * (xValue - xLim[0]) / (xLim[1] - xLim[0]);
+	float yPlot = yLogScale ? -dim[1] * log(yValue / yLim[0]) / log(yLim[1] / yLim[0]) :
+			-dim[1] * (yValue - yLim[0]) / (yLim[1] - yLim[0]);
+
+	return {xPlot, yPlot};
+}
+
+array<float, 2> ofxGPlot::plotToValue(float xPlot, float yPlot) const {
+	updateLim();
+
+	float xValue = xLogScale ? pow(10, log10(xLim[0]) + log10(xLim[1] / xLim[0]) * xPlot / dim[0]) :
+			xLim[0] + (xLim[1] - xLim[0]) * xPlot / dim[0];
+	float yValue = yLogScale ? pow(10, log10(yLim[0]) - log10(yLim[1] / yLim[0]) * yPlot / dim[1]) :
+			yLim[0] - (yLim[1] - yLim[0]) * yPlot / dim[1];
+
+	return {xValue, yValue};
+}
+
+void ofxGPlot::beginUpdate() {
+	++updateDepth;
+	mainLayer.beginUpdate();
 
 	for (ofxGLayer& layer : layerList) {
-		layer.setXYLim(xLim, yLim);
+		layer.beginUpdate();
 	}
 }
 
-array<float, 2> ofxGPlot::calculatePlotXLim() {
+void ofxGPlot::endUpdate() {
+	if (updateDepth == 0) {
+		ofLogWarning("endUpdate() was called without a matching beginUpdate()");
+		return;
+	}
+
+	--updateDepth;
+
+	// Pass the new limits to the layers before they recalculate their plot points
+	if (updateDepth == 0) {
+		update();
+	}
+
+	mainLayer.endUpdate();
+
+	for (ofxGLayer& layer : layerList) {
+		layer.endUpdate();
+	}
+}
+
+array<float, 2> ofxGPlot::calculatePlotXLim() const {
 	// Find the limits for the main layer
 	array<float, 2> lim = calculatePointsXLim(mainLayer.getPointsRef());
 
 	// Include the other layers in the limit calculation if necessary
 	if (includeAllLayersInLim) {
-		for (ofxGLayer& layer : layerList) {
+		for (const ofxGLayer& layer : layerList) {
 			array<float, 2> newLim = calculatePointsXLim(layer.getPointsRef());
 
 			if (isfinite(newLim[0])) {
@@ -331,13 +487,13 @@ array<float, 2> ofxGPlot::calculatePlotXLim() {
 	return lim;
 }
 
-array<float, 2> ofxGPlot::calculatePlotYLim() {
+array<float, 2> ofxGPlot::calculatePlotYLim() const {
 	// Find the limits for the main layer
 	array<float, 2> lim = calculatePointsYLim(mainLayer.getPointsRef());
 
 	// Include the other layers in the limit calculation if necessary
 	if (includeAllLayersInLim) {
-		for (ofxGLayer& layer : layerList) {
+		for (const ofxGLayer& layer : layerList) {
 			array<float, 2> newLim = calculatePointsYLim(layer.getPointsRef());
 
 			if (isfinite(newLim[0])) {
@@ -386,22 +542,23 @@ array<float, 2> ofxGPlot::calculatePlotYLim() {
 	return lim;
 }
 
-array<float, 2> ofxGPlot::calculatePointsXLim(const vector<ofxGPoint>& points) {
+array<float, 2> ofxGPlot::calculatePointsXLim(const ofxGPointArray& points) const {
+	// Use the limits tracked by the point array if all the points should be considered
+	if (!fixedYLim) {
+		return points.getXLim(xLogScale);
+	}
+
 	// Find the points limits
 	array<float, 2> lim = { numeric_limits<float>::infinity(), -numeric_limits<float>::infinity() };
 
-	for (const ofxGPoint& p : points) {
-		if (p.isValid()) {
+	for (ofxGPointArray::size_type i = 0; i < points.size(); ++i) {
+		if (points.isValid(i)) {
 			// Use the point if it's inside, and it's not negative if
 			// the scale is logarithmic
-			float x = p.getX();
-			float y = p.getY();
-			bool isInside = true;
-
-			if (fixedYLim) {
-				isInside = ((yLim[1] >= yLim[0]) && (y >= yLim[0]) && (y <= yLim[1]))
-						|| ((yLim[1] < yLim[0]) && (y <= yLim[0]) && (y >= yLim[1]));
-			}
+			float x = points.getX(i);
+			float y = points.getY(i);
+			bool isInside = ((yLim[1] >= yLim[0]) && (y >= yLim[0]) && (y <= yLim[1]))
+					|| ((yLim[1] < yLim[0]) && (y <= yLim[0]) && (y >= yLim[1]));
 
 			if (isInside && !(xLogScale && x <= 0)) {
 				if (x < lim[0]) {
@@ -423,22 +580,32 @@ array<float, 2> ofxGPlot::calculatePointsXLim(const vector<ofxGPoint>& points) {
 	return lim;
 }
 
-array<float, 2> ofxGPlot::calculatePointsYLim(const vector<ofxGPoint>& points) {
+array<float, 2> ofxGPlot::calculatePointsYLim(const ofxGPointArray& points) const {
+	// Use the limits tracked by the point array if all the points should be considered
+	if (!fixedXLim) {
+		return points.getYLim(yLogScale);
+	}
+
+	// If the points are sorted in x, only check the points between the x limits
+	ofxGPointArray::size_type first = 0;
+	ofxGPointArray::size_type last = points.size();
+
+	if (points.isSortedByX()) {
+		first = points.lowerBoundX(min(xLim[0], xLim[1]));
+		last = points.upperBoundX(max(xLim[0], xLim[1]));
+	}
+
 	// Find the points limits
 	array<float, 2> lim = { numeric_limits<float>::infinity(), -numeric_limits<float>::infinity() };
 
-	for (const ofxGPoint& p : points) {
-		if (p.isValid()) {
+	for (ofxGPointArray::size_type i = first; i < last; ++i) {
+		if (points.isValid(i)) {
 			// Use the point if it's inside, and it's not negative if
 			// the scale is logarithmic
-			float x = p.getX();
-			float y = p.getY();
-			bool isInside = true;
-
-			if (fixedXLim) {
-				isInside = ((xLim[1] >= xLim[0]) && (x >= xLim[0]) && (x <= xLim[1]))
-						|| ((xLim[1] < xLim[0]) && (x <= xLim[0]) && (x >= xLim[1]));
-			}
+			float x = points.getX(i);
+			float y = points.getY(i);
+			bool isInside = ((xLim[1] >= xLim[0]) && (x >= xLim[0]) && (x <= xLim[1]))
+					|| ((xLim[1] < xLim[0]) && (x <= xLim[0]) && (x >= xLim[1]));
 
 			if (isInside && !(yLogScale && y <= 0)) {
 				if (y < lim[0]) {
@@ -461,6 +628,8 @@ array<float, 2> ofxGPlot::calculatePointsYLim(const vector<ofxGPoint>& points) {
 }
 
 void ofxGPlot::moveHorizontalAxesLim(float delta) {
+	update();
+
 	// Obtain the new x limits
 	if (xLogScale) {
 		float deltaLim = pow(10, log10(xLim[1] / xLim[0]) * delta / dim[0]);
@@ -485,6 +654,8 @@ void ofxGPlot::moveHorizontalAxesLim(float delta) {
 }
 
 void ofxGPlot::moveVerticalAxesLim(float delta) {
+	update();
+
 	// Obtain the new y limits
 	if (yLogScale) {
 		float deltaLim = pow(10, log10(yLim[1] / yLim[0]) * delta / dim[1]);
@@ -509,6 +680,8 @@ void ofxGPlot::moveVerticalAxesLim(float delta) {
 }
 
 void ofxGPlot::centerAndZoom(float factor, float xValue, float yValue) {
+	update();
+
 	// Calculate the new limits
 	if (xLogScale) {
 		float deltaLim = pow(10, log10(xLim[1] / xLim[0]) / (2 * factor));
@@ -530,23 +703,23 @@ void ofxGPlot::centerAndZoom(float factor, float xValue, float yValue) {
 	fixedXLim = true;
 	fixedYLim = true;
 
-	// Update the horizontal and vertical axes
-	xAxis.setLim(xLim);
-	topAxis.setLim(xLim);
-	yAxis.setLim(yLim);
-	rightAxis.setLim(yLim);
-
-	// Update the plot limits (the layers, because the limits are fixed)
-	updateLimits();
+	// Update the horizontal and vertical axes and the layers
+	xAxesNeedUpdate = true;
+	yAxesNeedUpdate = true;
+	layersNeedUpdate = true;
 }
 
 void ofxGPlot::zoom(float factor) {
+	update();
+
 	array<float, 2> centerValue = mainLayer.plotToValue(dim[0] / 2, -dim[1] / 2);
 
 	centerAndZoom(factor, centerValue[0], centerValue[1]);
 }
 
 void ofxGPlot::zoom(float factor, float xScreen, float yScreen) {
+	update();
+
 	array<float, 2> plotPos = getPlotPosAt(xScreen, yScreen);
 	array<float, 2> value = mainLayer.plotToValue(plotPos[0], plotPos[1]);
 
@@ -574,17 +747,15 @@ void ofxGPlot::zoom(float factor, float xScreen, float yScreen) {
 	fixedXLim = true;
 	fixedYLim = true;
 
-	// Update the horizontal and vertical axes
-	xAxis.setLim(xLim);
-	topAxis.setLim(xLim);
-	yAxis.setLim(yLim);
-	rightAxis.setLim(yLim);
-
-	// Update the plot limits (the layers, because the limits are fixed)
-	updateLimits();
+	// Update the horizontal and vertical axes and the layers
+	xAxesNeedUpdate = true;
+	yAxesNeedUpdate = true;
+	layersNeedUpdate = true;
 }
 
 void ofxGPlot::shiftPlotPos(const array<float, 2>& valuePlotPos, const array<float, 2>& newPlotPos) {
+	update();
+
 	// Calculate the new limits
 	float deltaXPlot = valuePlotPos[0] - newPlotPos[0];
 	float deltaYPlot = valuePlotPos[1] - newPlotPos[1];
@@ -620,6 +791,8 @@ void ofxGPlot::shiftPlotPos(const array<float, 2>& valuePlotPos, const array<flo
 }
 
 void ofxGPlot::align(float xValue, float yValue, float xScreen, float yScreen) {
+	update();
+
 	array<float, 2> valuePlotPos = mainLayer.valueToPlot(xValue, yValue);
 	array<float, 2> newPlotPos = getPlotPosAt(xScreen, yScreen);
 
@@ -671,6 +844,12 @@ void ofxGPlot::beginDraw() const {
 	ofTranslate(pos[0] + mar[1], pos[1] + mar[2] + dim[1], 0);
 }
 
+void ofxGPlot::beginDraw() {
+	update();
+
+	static_cast<const ofxGPlot&>(*this).beginDraw();
+}
+
 void ofxGPlot::endDraw() const {
 	ofPopMatrix();
 	ofPopStyle();
@@ -770,27 +949,28 @@ void ofxGPlot::drawPoint(const ofxGPoint& point, const ofImage& pointImg) const
 	mainLayer.drawPoint(point, pointImg);
 }
 
-void ofxGPlot::drawLines() {
+void ofxGPlot::drawLines() const {
 	mainLayer.drawLines();
 
-	for (ofxGLayer& layer : layerList) {
+	for (const ofxGLayer& layer : layerList) {
 		layer.drawLines();
 	}
 }
 
-void ofxGPlot::drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lineColor, float lineWidth) {
+void ofxGPlot::drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lineColor,
+		float lineWidth) const {
 	mainLayer.drawLine(point1, point2, lineColor, lineWidth);
 }
 
-void ofxGPlot::drawLine(const ofxGPoint& point1, const ofxGPoint& point2) {
+void ofxGPlot::drawLine(const ofxGPoint& point1, const ofxGPoint& point2) const {
 	mainLayer.drawLine(point1, point2);
 }
 
-void ofxGPlot::drawLine(float slope, float yCut, const ofColor& lineColor, float lineWidth) {
+void ofxGPlot::drawLine(float slope, float yCut, const ofColor& lineColor, float lineWidth) const {
 	mainLayer.drawLine(slope, yCut, lineColor, lineWidth);
 }
 
-void ofxGPlot::drawLine(float slope, float yCut) {
+void ofxGPlot::drawLine(float slope, float yCut) const {
 	mainLayer.drawLine(slope, yCut);
 }
 
@@ -810,10 +990,10 @@ void ofxGPlot::drawVerticalLine(float value) const {
 	mainLayer.drawVerticalLine(value);
 }
 
-void ofxGPlot::drawFilledContours(ofxGContourType contourType, float referenceValue) {
+void ofxGPlot::drawFilledContours(ofxGContourType contourType, float referenceValue) const {
 	mainLayer.drawFilledContour(contourType, referenceValue);
 
-	for (ofxGLayer& layer : layerList) {
+	for (const ofxGLayer& layer : layerList) {
 		layer.drawFilledContour(contourType, referenceValue);
 	}
 }
@@ -873,10 +1053,22 @@ void ofxGPlot::drawHistograms() {
 	}
 }
 
+void ofxGPlot::drawDensities() const {
+	mainLayer.drawDensity();
+
+	for (const ofxGLayer& layer : layerList) {
+		layer.drawDensity();
+	}
+}
+
 void ofxGPlot::drawPolygon(const vector<ofxGPoint>& polygonPoints, const ofColor& polygonColor) {
 	mainLayer.drawPolygon(polygonPoints, polygonColor);
 }
 
+void ofxGPlot::drawPolygons(const vector<vector<ofxGPoint>>& polygons, const vector<ofColor>& polygonColors) {
+	mainLayer.drawPolygons(polygons, polygonColors);
+}
+
 void ofxGPlot::drawAnnotation(const string& text, float x, float y, ofxGTextAlignment verAlign) const {
 	mainLayer.drawAnnotation(text, x, y, verAlign);
 }
@@ -922,18 +1114,7 @@ void ofxGPlot::setOuterDim(float xOuterDim, float yOuterDim) {
 		if (xDim > 0 && yDim > 0) {
 			outerDim = {xOuterDim, yOuterDim};
 			dim = {xDim, yDim};
-			xAxis.setDim(dim);
-			topAxis.setDim(dim);
-			yAxis.setDim(dim);
-			rightAxis.setDim(dim);
-			title.setDim(dim);
-
-			// Update the layers
-			mainLayer.setDim(dim);
-
-			for (ofxGLayer& layer : layerList) {
-				layer.setDim(dim);
-			}
+			dimNeedsUpdate = true;
 		}
 	}
 }
@@ -966,18 +1147,7 @@ void ofxGPlot::setDim(float xDim, float yDim) {
 		if (xOuterDim > 0 && yOuterDim > 0) {
 			outerDim = {xOuterDim, yOuterDim};
 			dim = {xDim, yDim};
-			xAxis.setDim(dim);
-			topAxis.setDim(dim);
-			yAxis.setDim(dim);
-			rightAxis.setDim(dim);
-			title.setDim(dim);
-
-			// Update the layers
-			mainLayer.setDim(dim);
-
-			for (ofxGLayer& layer : layerList) {
-				layer.setDim(dim);
-			}
+			dimNeedsUpdate = true;
 		}
 	}
 }
@@ -1000,11 +1170,8 @@ void ofxGPlot::setXLim(float lowerLim, float upperLim) {
 	// Fix the limits
 	fixedXLim = true;
 
-	// Update the axes
-	xAxis.setLim(xLim);
-	topAxis.setLim(xLim);
-
-	// Update the plot limits
+	// Update the axes and the plot limits
+	xAxesNeedUpdate = true;
 	updateLimits();
 }
 
@@ -1026,11 +1193,8 @@ void ofxGPlot::setYLim(float lowerLim, float upperLim) {
 	// Fix the limits
 	fixedYLim = true;
 
-	// Update the axes
-	yAxis.setLim(yLim);
-	rightAxis.setLim(yLim);
-
-	// Update the plot limits
+	// Update the axes and the plot limits
+	yAxesNeedUpdate = true;
 	updateLimits();
 }
 
@@ -1085,27 +1249,10 @@ void ofxGPlot::setLogScale(const string& logType) {
 			fixedYLim = false;
 		}
 
-		// Calculate the new limits if needed
-		if (!fixedXLim) {
-			xLim = calculatePlotXLim();
-		}
-
-		if (!fixedYLim) {
-			yLim = calculatePlotYLim();
-		}
-
-		// Update the axes
-		xAxis.setLimAndLogScale(xLim, xLogScale);
-		topAxis.setLimAndLogScale(xLim, xLogScale);
-		yAxis.setLimAndLogScale(yLim, yLogScale);
-		rightAxis.setLimAndLogScale(yLim, yLogScale);
-
-		// Update the layers
-		mainLayer.setLimAndLogScale(xLim, yLim, xLogScale, yLogScale);
-
-		for (ofxGLayer& layer : layerList) {
-			layer.setLimAndLogScale(xLim, yLim, xLogScale, yLogScale);
-		}
+		// Update the axes, the plot limits and the layers
+		xAxesNeedUpdate = true;
+		yAxesNeedUpdate = true;
+		updateLimits();
 	}
 }
 
@@ -1114,16 +1261,9 @@ void ofxGPlot::setInvertedXScale(bool newInvertedXScale) {
 		invertedXScale = newInvertedXScale;
 		xLim = {xLim[1], xLim[0]};
 
-		// Update the axes
-		xAxis.setLim(xLim);
-		topAxis.setLim(xLim);
-
-		// Update the layers
-		mainLayer.setXLim(xLim);
-
-		for (ofxGLayer& layer : layerList) {
-			layer.setXLim(xLim);
-		}
+		// Update the axes and the layers
+		xAxesNeedUpdate = true;
+		layersNeedUpdate = true;
 	}
 }
 
@@ -1136,16 +1276,9 @@ void ofxGPlot::setInvertedYScale(bool newInvertedYScale) {
 		invertedYScale = newInvertedYScale;
 		yLim = {yLim[1], yLim[0]};
 
-		// Update the axes
-		yAxis.setLim(yLim);
-		rightAxis.setLim(yLim);
-
-		// Update the layers
-		mainLayer.setYLim(yLim);
-
-		for (ofxGLayer& layer : layerList) {
-			layer.setYLim(yLim);
-		}
+		// Update the axes and the layers
+		yAxesNeedUpdate = true;
+		layersNeedUpdate = true;
 	}
 }
 
@@ -1209,12 +1342,36 @@ void ofxGPlot::setGridLineWidth(float newGridLineWidth) {
 }
 
 void ofxGPlot::setPoints(const vector<ofxGPoint>& points) {
+	deferLayersUpdate();
 	mainLayer.setPoints(points);
 	updateLimits();
 }
 
 void ofxGPlot::setPoints(const vector<ofxGPoint>& points, const string& layerId) {
-	getLayer(layerId).setPoints(points);
+	deferLayersUpdate();
+	findLayer(layerId).setPoints(points);
+	updateLimits();
+}
+
+void ofxGPlot::setPoints(const ofxGPointSpan& points) {
+	deferLayersUpdate();
+	mainLayer.setPoints(points);
+	updateLimits();
+}
+
+void ofxGPlot::setPoints(const ofxGPointSpan& points, const string& layerId) {
+	deferLayersUpdate();
+	findLayer(layerId).setPoints(points);
+	updateLimits();
+}
+
+void ofxGPlot::markPointsDirty(int first, int last) {
+	mainLayer.markPointsDirty(first, last);
+	updateLimits();
+}
+
+void ofxGPlot::markPointsDirty(int first, int last, const string& layerId) {
+	findLayer(layerId).markPointsDirty(first, last);
 	updateLimits();
 }
 
@@ -1224,7 +1381,7 @@ void ofxGPlot::setPoint(int index, float x, float y, const string& label) {
 }
 
 void ofxGPlot::setPoint(int index, float x, float y, const string& label, const string& layerId) {
-	getLayer(layerId).setPoint(index, x, y, label);
+	findLayer(layerId).setPoint(index, x, y, label);
 	updateLimits();
 }
 
@@ -1239,7 +1396,7 @@ void ofxGPlot::setPoint(int index, const ofxGPoint& newPoint) {
 }
 
 void ofxGPlot::setPoint(int index, const ofxGPoint& newPoint, const string& layerId) {
-	getLayer(layerId).setPoint(index, newPoint);
+	findLayer(layerId).setPoint(index, newPoint);
 	updateLimits();
 }
 
@@ -1249,7 +1406,7 @@ void ofxGPlot::addPoint(float x, float y, const string& label) {
 }
 
 void ofxGPlot::addPoint(float x, float y, const string& label, const string& layerId) {
-	getLayer(layerId).addPoint(x, y, label);
+	findLayer(layerId).addPoint(x, y, label);
 	updateLimits();
 }
 
@@ -1264,7 +1421,7 @@ void ofxGPlot::addPoint(const ofxGPoint& newPoint) {
 }
 
 void ofxGPlot::addPoint(const ofxGPoint& newPoint, const string& layerId) {
-	getLayer(layerId).addPoint(newPoint);
+	findLayer(layerId).addPoint(newPoint);
 	updateLimits();
 }
 
@@ -1274,7 +1431,7 @@ void ofxGPlot::addPoint(int index, float x, float y, const string& label) {
 }
 
 void ofxGPlot::addPoint(int index, float x, float y, const string& label, const string& layerId) {
-	getLayer(layerId).addPoint(index, x, y, label);
+	findLayer(layerId).addPoint(index, x, y, label);
 	updateLimits();
 }
 
@@ -1289,7 +1446,7 @@ void ofxGPlot::addPoint(int index, const ofxGPoint& newPoint) {
 }
 
 void ofxGPlot::addPoint(int index, const ofxGPoint& newPoint, const string& layerId) {
-	getLayer(layerId).addPoint(index, newPoint);
+	findLayer(layerId).addPoint(index, newPoint);
 	updateLimits();
 }
 
@@ -1299,7 +1456,7 @@ void ofxGPlot::addPoints(const vector<ofxGPoint>& newPoints) {
 }
 
 void ofxGPlot::addPoints(const vector<ofxGPoint>& newPoints, const string& layerId) {
-	getLayer(layerId).addPoints(newPoints);
+	findLayer(layerId).addPoints(newPoints);
 	updateLimits();
 }
 
@@ -1309,7 +1466,17 @@ void ofxGPlot::removePoint(int index) {
 }
 
 void ofxGPlot::removePoint(int index, const string& layerId) {
-	getLayer(layerId).removePoint(index);
+	findLayer(layerId).removePoint(index);
+	updateLimits();
+}
+
+void ofxGPlot::setPointsCapacity(int capacity) {
+	mainLayer.setPointsCapacity(capacity);
+	updateLimits();
+}
+
+void ofxGPlot::setPointsCapacity(int capacity, const string& layerId) {
+	findLayer(layerId).setPointsCapacity(capacity);
 	updateLimits();
 }
 
@@ -1337,6 +1504,18 @@ void ofxGPlot::setLineWidth(float lineWidth) {
 	mainLayer.setLineWidth(lineWidth);
 }
 
+void ofxGPlot::setLinesDecimation(bool decimate) {
+	mainLayer.setLinesDecimation(decimate);
+}
+
+void ofxGPlot::setDownsampling(int nPoints) {
+	mainLayer.setDownsampling(nPoints);
+}
+
+void ofxGPlot::setDensityColors(const vector<ofColor>& colors) {
+	mainLayer.setDensityColors(colors);
+}
+
 void ofxGPlot::setHistBasePoint(const ofxGPoint& basePoint) {
 	mainLayer.setHistBasePoint(basePoint);
 }
@@ -1470,10 +1649,14 @@ array<float, 2> ofxGPlot::getDim() const {
 }
 
 array<float, 2> ofxGPlot::getXLim() const {
+	updateLim();
+
 	return xLim;
 }
 
 array<float, 2> ofxGPlot::getYLim() const {
+	updateLim();
+
 	return yLim;
 }
 
@@ -1502,10 +1685,18 @@ bool ofxGPlot::getInvertedYScale() {
 }
 
 ofxGLayer& ofxGPlot::getMainLayer() {
+	update();
+
 	return mainLayer;
 }
 
 ofxGLayer& ofxGPlot::getLayer(const string& layerId) {
+	update();
+
+	return findLayer(layerId);
+}
+
+ofxGLayer& ofxGPlot::findLayer(const string& layerId) {
 	if (mainLayer.isId(layerId)) {
 		return mainLayer;
 	}
@@ -1520,22 +1711,32 @@ ofxGLayer& ofxGPlot::getLayer(const string& layerId) {
 }
 
 ofxGAxis& ofxGPlot::getXAxis() {
+	update();
+
 	return xAxis;
 }
 
 ofxGAxis& ofxGPlot::getTopAxis() {
+	update();
+
 	return topAxis;
 }
 
 ofxGAxis& ofxGPlot::getYAxis() {
+	update();
+
 	return yAxis;
 }
 
 ofxGAxis& ofxGPlot::getRightAxis() {
+	update();
+
 	return rightAxis;
 }
 
 ofxGTitle& ofxGPlot::getTitle() {
+	update();
+
 	return title;
 }
 
@@ -1557,11 +1758,11 @@ vector<ofxGPoint> ofxGPlot::getPoints(const string& layerId) const {
 	throw invalid_argument("Couldn't find a layer with id = " + layerId);
 }
 
-const vector<ofxGPoint>& ofxGPlot::getPointsRef() const {
+const ofxGPointArray& ofxGPlot::getPointsRef() const {
 	return mainLayer.getPointsRef();
 }
 
-const vector<ofxGPoint>& ofxGPlot::getPointsRef(const string& layerId) const {
+const ofxGPointArray& ofxGPlot::getPointsRef(const string& layerId) const {
 	if (mainLayer.isId(layerId)) {
 		return mainLayer.getPointsRef();
 	}
@@ -1576,6 +1777,8 @@ const vector<ofxGPoint>& ofxGPlot::getPointsRef(const string& layerId) const {
 }
 
 ofxGHistogram& ofxGPlot::getHistogram() {
+	update();
+
 	return mainLayer.getHistogram();
 }
 
@@ -1687,6 +1890,8 @@ void ofxGPlot::deactivateReset() {
 
 void ofxGPlot::mouseEventHandler(ofMouseEventArgs& args) {
 	if (zoomingIsActive || centeringIsActive || panningIsActive || labelingIsActive || resetIsActive) {
+		update();
+
 		ofMouseEventArgs::Type eventType = args.type;
 		int button = args.button;
 		float xPos = args.x;
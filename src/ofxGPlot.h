@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ofxGConstants.h"
+#include "ofxGPointArray.h"
+#include "ofxGPointSpan.h"
 #include "ofxGLayer.h"
 #include "ofxGAxis.h"
 #include "ofxGTitle.h"
@@ -75,7 +77,8 @@ public:
 	array<float, 2> getScreenPosAtValue(float xValue, float yValue) const;
 
 	/**
-	 * @brief Returns the closest point in the main layer to a given screen position
+	 * @brief Returns the closest point in the main layer to a given screen position. It uses the layer as it was after
+	 * the last update
 	 *
 	 * @param xScreen x screen position
 	 * @param yScreen y screen position
@@ -85,7 +88,19 @@ public:
 	const ofxGPoint* getPointAt(float xScreen, float yScreen) const;
 
 	/**
-	 * @brief Returns the closest point in the specified layer to a given screen position
+	 * @brief Returns the closest point in the main layer to a given screen position, applying first the pending plot
+	 * changes
+	 *
+	 * @param xScreen x screen position
+	 * @param yScreen y screen position
+	 *
+	 * @return a pointer to the closest point in the plot main layer. nullptr if there is not a close point
+	 */
+	const ofxGPoint* getPointAt(float xScreen, float yScreen);
+
+	/**
+	 * @brief Returns the closest point in the specified layer to a given screen position. It uses the layer as it was
+	 * after the last update
 	 *
 	 * @param xScreen x screen position
 	 * @param yScreen y screen position
@@ -95,6 +110,18 @@ public:
 	 */
 	const ofxGPoint* getPointAt(float xScreen, float yScreen, const string& layerId) const;
 
+	/**
+	 * @brief Returns the closest point in the specified layer to a given screen position, applying first the pending
+	 * plot changes
+	 *
+	 * @param xScreen x screen position
+	 * @param yScreen y screen position
+	 * @param layerId the layer id
+	 *
+	 * @return a pointer to the closest point in the specified layer. nullptr if there is not a close point
+	 */
+	const ofxGPoint* getPointAt(float xScreen, float yScreen, const string& layerId);
+
 	/**
 	 * @brief Adds a point to the main layer at a given screen position
 	 *
@@ -170,10 +197,32 @@ public:
 	bool isOverBox(float xScreen, float yScreen) const;
 
 	/**
-	 * @brief Calculates and updates the plot x and y limits
+	 * @brief Marks the plot x and y limits for recalculation. They are calculated at the next update
 	 */
 	void updateLimits();
 
+	/**
+	 * @brief Applies the pending changes to the plot limits, the axes, the title and the layers
+	 *
+	 * The plot setters only record what changed, so several consecutive changes cost a single update. This method is
+	 * called automatically by beginDraw() and by the non-const methods that need the updated plot components.
+	 */
+	void update();
+
+	/**
+	 * @brief Starts a batch of point modifications in all the plot layers
+	 *
+	 * Until the matching endUpdate() call, adding, setting or removing points only modifies the layer points. The
+	 * plot limits, the layers plot points and the histograms are recalculated once, when the outermost batch finishes.
+	 * Calls can be nested.
+	 */
+	void beginUpdate();
+
+	/**
+	 * @brief Finishes a batch of point modifications and updates the plot if it was the outermost batch
+	 */
+	void endUpdate();
+
 	/**
 	 * @brief Calculates the x limits of a given set of points, considering the plot properties (axis log scale, if the
 	 * other axis limits are fixed, etc)
@@ -182,7 +231,7 @@ public:
 	 *
 	 * @return the x limits. Null if none of the points satisfies the plot properties
 	 */
-	array<float, 2> calculatePointsXLim(const vector<ofxGPoint>& points);
+	array<float, 2> calculatePointsXLim(const ofxGPointArray& points) const;
 
 	/**
 	 * @brief Calculates the y limits of a given set of points, considering the plot properties (axis log scale, if the
@@ -192,7 +241,7 @@ public:
 	 *
 	 * @return the y limits. Null if none of the points satisfies the plot properties
 	 */
-	array<float, 2> calculatePointsYLim(const vector<ofxGPoint>& points);
+	array<float, 2> calculatePointsYLim(const ofxGPointArray& points) const;
 
 	/**
 	 * @brief Moves the horizontal axes limits by a given amount specified in pixel units
@@ -282,9 +331,17 @@ public:
 	/**
 	 * @brief Prepares the environment to start drawing the different plot components (points, axes, title, etc). Use
 	 * endDraw() to return the sketch to its original state
+	 *
+	 * A const plot can't apply its pending changes, so it's drawn as it was after the last update.
 	 */
 	void beginDraw() const;
 
+	/**
+	 * @brief Applies the pending plot changes and prepares the environment to start drawing the different plot
+	 * components (points, axes, title, etc). Use endDraw() to return the sketch to its original state
+	 */
+	void beginDraw();
+
 	/**
 	 * @brief Returns the sketch to the state that it had before calling beginDraw()
 	 */
@@ -395,7 +452,7 @@ public:
 	/**
 	 * @brief Draws lines connecting the points from all layers in the plot
 	 */
-	void drawLines();
+	void drawLines() const;
 
 	/**
 	 * @brief Draws a line in the plot, defined by two extreme points
@@ -405,7 +462,7 @@ public:
 	 * @param lineColor line color
 	 * @param lineWidth line width
 	 */
-	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lineColor, float lineWidth);
+	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2, const ofColor& lineColor, float lineWidth) const;
 
 	/**
 	 * @brief Draws a line in the plot, defined by two extreme points
@@ -413,7 +470,7 @@ public:
 	 * @param point1 first point
 	 * @param point2 second point
 	 */
-	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2);
+	void drawLine(const ofxGPoint& point1, const ofxGPoint& point2) const;
 
 	/**
 	 * @brief Draws a line in the plot, defined by the slope and the cut in the y axis
@@ -423,7 +480,7 @@ public:
 	 * @param lineColor line color
 	 * @param lineWidth line width
 	 */
-	void drawLine(float slope, float yCut, const ofColor& lineColor, float lineWidth);
+	void drawLine(float slope, float yCut, const ofColor& lineColor, float lineWidth) const;
 
 	/**
 	 * @brief Draws a line in the plot, defined by the slope and the cut in the y axis
@@ -431,7 +488,7 @@ public:
 	 * @param slope the line slope
 	 * @param yCut the line y axis cut
 	 */
-	void drawLine(float slope, float yCut);
+	void drawLine(float slope, float yCut) const;
 
 	/**
 	 * @brief Draws an horizontal line in the plot
@@ -471,7 +528,7 @@ public:
 	 * @param contourType the type of contours to use. It can be GPlot.VERTICAL or GPlot.HORIZONTAL
 	 * @param referenceValue the reference value to use to close the contour
 	 */
-	void drawFilledContours(ofxGContourType contourType, float referenceValue);
+	void drawFilledContours(ofxGContourType contourType, float referenceValue) const;
 
 	/**
 	 * @brief Draws the label of a given point
@@ -506,6 +563,11 @@ public:
 	 */
 	void drawHistograms();
 
+	/**
+	 * @brief Draws the points density of all layers
+	 */
+	void drawDensities() const;
+
 	/**
 	 * @brief Draws a polygon defined by a set of points
 	 *
@@ -514,6 +576,14 @@ public:
 	 */
 	void drawPolygon(const vector<ofxGPoint>& polygonPoints, const ofColor& polygonColor);
 
+	/**
+	 * @brief Draws a set of polygons in a single batch
+	 *
+	 * @param polygons the points that define each polygon
+	 * @param polygonColors the polygon colors. They are applied cyclically to the polygons
+	 */
+	void drawPolygons(const vector<vector<ofxGPoint>>& polygons, const vector<ofColor>& polygonColors);
+
 	/**
 	 * @brief Draws an annotation at a given plot value
 	 *
@@ -742,6 +812,38 @@ public:
 	 */
 	void setPoints(const vector<ofxGPoint>& points, const string& layerId);
 
+	/**
+	 * @brief Sets the points for the main layer to the points stored in a span. The points are not copied
+	 *
+	 * @param points the span with the new points for the main layer. Its memory should stay valid while it's used
+	 */
+	void setPoints(const ofxGPointSpan& points);
+
+	/**
+	 * @brief Sets the points for the specified layer to the points stored in a span. The points are not copied
+	 *
+	 * @param points the span with the new points for the layer. Its memory should stay valid while it's used
+	 * @param layerId the layer id
+	 */
+	void setPoints(const ofxGPointSpan& points, const string& layerId);
+
+	/**
+	 * @brief Informs the main layer that the values of some of its span points changed
+	 *
+	 * @param first the position of the first point that changed
+	 * @param last the position after the last point that changed
+	 */
+	void markPointsDirty(int first, int last);
+
+	/**
+	 * @brief Informs the specified layer that the values of some of its span points changed
+	 *
+	 * @param first the position of the first point that changed
+	 * @param last the position after the last point that changed
+	 * @param layerId the layer id
+	 */
+	void markPointsDirty(int first, int last, const string& layerId);
+
 	/**
 	 * @brief Sets one of the main layer points
 	 *
@@ -908,6 +1010,23 @@ public:
 	 */
 	void removePoint(int index, const string& layerId);
 
+	/**
+	 * @brief Sets the maximum number of points in the main layer. When the layer is full, adding a new point removes the
+	 * oldest one
+	 *
+	 * @param capacity the maximum number of points. Use 0 for no limit
+	 */
+	void setPointsCapacity(int capacity);
+
+	/**
+	 * @brief Sets the maximum number of points in one of the plot layers. When the layer is full, adding a new point
+	 * removes the oldest one
+	 *
+	 * @param capacity the maximum number of points. Use 0 for no limit
+	 * @param layerId the layer id
+	 */
+	void setPointsCapacity(int capacity, const string& layerId);
+
 	/**
 	 * @brief Sets the point colors for the main layer
 	 *
@@ -950,6 +1069,27 @@ public:
 	 */
 	void setLineWidth(float lineWidth);
 
+	/**
+	 * @brief Sets if the main layer lines should be decimated to at most four vertices per pixel column
+	 *
+	 * @param decimate true if the lines should be decimated
+	 */
+	void setLinesDecimation(bool decimate);
+
+	/**
+	 * @brief Sets the maximum number of points that will be used to draw the main layer points and lines
+	 *
+	 * @param nPoints the maximum number of points. Use 0 to draw all the points
+	 */
+	void setDownsampling(int nPoints);
+
+	/**
+	 * @brief Sets the colors used to draw the main layer points density
+	 *
+	 * @param colors the colormap colors, from the lowest to the highest density
+	 */
+	void setDensityColors(const vector<ofColor>& colors);
+
 	/**
 	 * @brief Sets the base point for the histogram in the main layer
 	 *
@@ -1260,7 +1400,7 @@ public:
 	 *
 	 * @return the points of the main layer
 	 */
-	const vector<ofxGPoint>& getPointsRef() const;
+	const ofxGPointArray& getPointsRef() const;
 
 	/**
 	 * @brief Returns the points of the specified layer
@@ -1269,7 +1409,7 @@ public:
 	 *
 	 * @return the points of the specified layer
 	 */
-	const vector<ofxGPoint>& getPointsRef(const string& layerId) const;
+	const ofxGPointArray& getPointsRef(const string& layerId) const;
 
 	/**
 	 * @brief Returns the histogram of the main layer
@@ -1450,19 +1590,59 @@ public:
 
 protected:
 
+	/**
+	 * @brief Recalculates the plot limits if they are marked for recalculation. It only modifies the limits and the
+	 * pending update flags, so the const methods can use it
+	 */
+	void updateLim() const;
+
+	/**
+	 * @brief Starts a batch in all the layers, so their plot points are recalculated only once at the next update
+	 */
+	void deferLayersUpdate();
+
+	/**
+	 * @brief Calculates the position of a value in the plot reference system, using the current plot limits
+	 *
+	 * @param xValue the x value
+	 * @param yValue the y value
+	 *
+	 * @return the x and y positions in the plot reference system
+	 */
+	array<float, 2> valueToPlot(float xValue, float yValue) const;
+
+	/**
+	 * @brief Calculates the value of a position in the plot reference system, using the current plot limits
+	 *
+	 * @param xPlot x position in the plot reference system
+	 * @param yPlot y position in the plot reference system
+	 *
+	 * @return the x and y values
+	 */
+	array<float, 2> plotToValue(float xPlot, float yPlot) const;
+
 	/**
 	 * @brief Calculates the plot x limits
 	 *
 	 * @return the x limits
 	 */
-	array<float, 2> calculatePlotXLim();
+	array<float, 2> calculatePlotXLim() const;
 
 	/**
 	 * @brief Calculates the plot y limits
 	 *
 	 * @return the y limits
 	 */
-	array<float, 2> calculatePlotYLim();
+	array<float, 2> calculatePlotYLim() const;
+
+	/**
+	 * @brief Returns a layer with an specific id, without applying the pending plot changes
+	 *
+	 * @param layerId the id of the layer to return
+	 *
+	 * @return the layer with the specified id
+	 */
+	ofxGLayer& findLayer(const string& layerId);
 
 	/**
 	 * @brief Shifts the plot coordinates in a way that the value at a given plot position will have after that the
@@ -1510,12 +1690,12 @@ protected:
 	/**
 	 * @brief The limits of the horizontal axes
 	 */
-	array<float, 2> xLim;
+	mutable array<float, 2> xLim;
 
 	/**
 	 * @brief The limits of the vertical axes
 	 */
-	array<float, 2> yLim;
+	mutable array<float, 2> yLim;
 
 	/**
 	 * @brief Defines if the horizontal axes limits are fixed
@@ -1557,6 +1737,41 @@ protected:
 	 */
 	float expandLimFactor;
 
+	/**
+	 * @brief Defines if the plot limits should be recalculated at the next update
+	 */
+	mutable bool limitsNeedUpdate;
+
+	/**
+	 * @brief Defines if the plot dimensions should be passed to the axes, title and layers at the next update
+	 */
+	bool dimNeedsUpdate;
+
+	/**
+	 * @brief Defines if the horizontal axes limits and scale should be updated at the next update
+	 */
+	mutable bool xAxesNeedUpdate;
+
+	/**
+	 * @brief Defines if the vertical axes limits and scale should be updated at the next update
+	 */
+	mutable bool yAxesNeedUpdate;
+
+	/**
+	 * @brief Defines if the layers dimensions, limits and scales should be updated at the next update
+	 */
+	mutable bool layersNeedUpdate;
+
+	/**
+	 * @brief The number of nested point modification batches in progress
+	 */
+	int updateDepth;
+
+	/**
+	 * @brief Defines if the plot has started a batch in the layers to recalculate their plot points at the next update
+	 */
+	bool layersUpdateDeferred;
+
 	/**
 	 * @brief The plot background color
 	 */
@@ -0,0 +1,899 @@
+#include "ofxGPointArray.h"
+#include "ofxGPoint.h"
+#include "ofxGLimitsTracker.h"
+#include "ofxGPointSpan.h"
+#include "ofMain.h"
+
+#if defined(__AVX2__)
+#define OFXG_USE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OFXG_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OFXG_USE_NEON
+#include <arm_neon.h>
+#endif
+
+ofxGPointArray::ofxGPointArray() :
+		head(0), count(0), capacity(0), sortedByX(false), limitsNeedUpdate(true), external(false),
+		transformedView(false), viewOffsets( { 0, 0 }), viewFactors( { 1, 1 }), viewLogScales( { false, false }),
+		viewBoxDim( { 0, 0 }) {
+}
+
+ofxGPointArray::ofxGPointArray(const vector<ofxGPoint>& pts) :
+		head(0), count(0), capacity(0), sortedByX(false), limitsNeedUpdate(true), external(false),
+		transformedView(false), viewOffsets( { 0, 0 }), viewFactors( { 1, 1 }), viewLogScales( { false, false }),
+		viewBoxDim( { 0, 0 }) {
+	set(pts);
+}
+
+ofxGPointArray::size_type ofxGPointArray::size() const {
+	return count;
+}
+
+bool ofxGPointArray::empty() const {
+	return count == 0;
+}
+
+void ofxGPointArray::clear() {
+	xs.clear();
+	ys.clear();
+	valid.clear();
+	inside.clear();
+	labels.clear();
+	span = ofxGPointSpan();
+	external = false;
+	head = 0;
+	count = 0;
+	invalidateLimits();
+}
+
+void ofxGPointArray::reserve(size_type n) {
+	if (external) {
+		detach();
+	}
+
+	if (n > xs.size()) {
+		linearize();
+		setStorageSize(n);
+	}
+}
+
+void ofxGPointArray::resize(size_type n) {
+	if (external) {
+		detach();
+	}
+
+	linearize();
+	invalidateLimits();
+
+	if (n > xs.size()) {
+		setStorageSize(n);
+	}
+
+	// The new points are valid and are not inside the plot box
+	for (size_type i = count; i < n; ++i) {
+		xs[i] = 0;
+		ys[i] = 0;
+		setBit(valid, i, true);
+		setBit(inside, i, false);
+
+		if (!labels.empty()) {
+			labels[i].clear();
+		}
+	}
+
+	count = n;
+
+	if (capacity > 0 && count > capacity) {
+		removeFront(count - capacity);
+	}
+}
+
+void ofxGPointArray::setCapacity(size_type newCapacity) {
+	capacity = newCapacity;
+
+	// The limits trackers only need to support removals at the beginning if the array has a fixed capacity
+	if ((capacity > 0) != xLimits.isSlidingWindow()) {
+		invalidateLimits();
+	}
+
+	// The capacity is applied to external arrays when they are detached
+	if (capacity > 0 && !external) {
+		if (count > capacity) {
+			removeFront(count - capacity);
+		}
+
+		reserve(capacity);
+	}
+}
+
+ofxGPointArray::size_type ofxGPointArray::getCapacity() const {
+	return capacity;
+}
+
+void ofxGPointArray::set(const vector<ofxGPoint>& pts) {
+	// Keep only the most recent points if the array has a limited capacity
+	size_type first = (capacity > 0 && pts.size() > capacity) ? pts.size() - capacity : 0;
+	size_type n = pts.size() - first;
+	xs.resize(n);
+	ys.resize(n);
+	valid.assign((n + 63) / 64, 0);
+	inside.assign((n + 63) / 64, 0);
+	labels.clear();
+	span = ofxGPointSpan();
+	external = false;
+	head = 0;
+	count = n;
+	invalidateLimits();
+
+	for (size_type i = 0; i < n; ++i) {
+		const ofxGPoint& p = pts[first + i];
+		xs[i] = p.getX();
+		ys[i] = p.getY();
+		setBit(valid, i, p.isValid());
+
+		if (p.getLabel() != "") {
+			if (labels.empty()) {
+				labels.resize(n);
+			}
+
+			labels[i] = p.getLabel();
+		}
+	}
+}
+
+void ofxGPointArray::set(const ofxGPointSpan& pts, const vector<string>& newLabels) {
+	if (!newLabels.empty() && newLabels.size() != pts.size()) {
+		throw invalid_argument("The labels vector should have the same size as the span.");
+	}
+
+	// Keep only the most recent points if the array has a limited capacity
+	size_type first = (capacity > 0 && pts.size() > capacity) ? pts.size() - capacity : 0;
+	size_type n = pts.size() - first;
+	xs.resize(n);
+	ys.resize(n);
+	valid.assign((n + 63) / 64, 0);
+	inside.assign((n + 63) / 64, 0);
+	pts.copyTo(first, n, xs.data(), ys.data());
+
+	for (size_type i = 0; i < n; ++i) {
+		setBit(valid, i, pts.isValid(first + i));
+	}
+
+	if (newLabels.empty()) {
+		labels.clear();
+	} else {
+		labels.assign(newLabels.begin() + first, newLabels.end());
+	}
+
+	span = ofxGPointSpan();
+	external = false;
+	head = 0;
+	count = n;
+	invalidateLimits();
+}
+
+void ofxGPointArray::setExternal(const ofxGPointSpan& newSpan) {
+	// Release the array storage. The points will be read from the span
+	vector<float>().swap(xs);
+	vector<float>().swap(ys);
+	vector<uint64_t>().swap(valid);
+	vector<uint64_t>().swap(inside);
+	vector<string>().swap(labels);
+	span = newSpan;
+	external = true;
+	transformedView = false;
+	head = 0;
+	count = span.size();
+	invalidateLimits();
+}
+
+bool ofxGPointArray::isExternal() const {
+	return external;
+}
+
+void ofxGPointArray::detach() {
+	if (!external) {
+		return;
+	}
+
+	// Copy the span points to a linear storage, applying the transformation if the array is a transformed view
+	xs.resize(count);
+	ys.resize(count);
+	valid.assign((count + 63) / 64, 0);
+	inside.assign((count + 63) / 64, 0);
+
+	if (transformedView) {
+		transformRange(*this, 0, count, viewOffsets, viewFactors, viewLogScales, viewBoxDim);
+	} else {
+		span.copyTo(0, count, xs.data(), ys.data());
+
+		for (size_type i = 0; i < count; ++i) {
+			setBit(valid, i, isfinite(xs[i]) && isfinite(ys[i]));
+		}
+	}
+
+	span = ofxGPointSpan();
+	external = false;
+
+	if (capacity > 0 && count > capacity) {
+		removeFront(count - capacity);
+	}
+}
+
+void ofxGPointArray::markDirty() {
+	invalidateLimits();
+}
+
+void ofxGPointArray::set(size_type index, float x, float y, const string& label) {
+	setXY(index, x, y);
+	setLabel(index, label);
+}
+
+void ofxGPointArray::setXY(size_type index, float x, float y) {
+	if (external) {
+		detach();
+	}
+
+	size_type pos = physicalIndex(index);
+	xs[pos] = x;
+	ys[pos] = y;
+	setBit(valid, pos, isfinite(x) && isfinite(y));
+	invalidateLimits();
+}
+
+void ofxGPointArray::setLabel(size_type index, const string& label) {
+	if (external) {
+		detach();
+	}
+
+	if (!labels.empty()) {
+		labels[physicalIndex(index)] = label;
+	} else if (label != "") {
+		labels.resize(xs.size());
+		labels[physicalIndex(index)] = label;
+	}
+}
+
+void ofxGPointArray::setInside(size_type index, bool newInside) {
+	if (external) {
+		detach();
+	}
+
+	setBit(inside, physicalIndex(index), newInside);
+}
+
+void ofxGPointArray::setTransformed(const ofxGPointArray& source, const array<float, 2>& offsets,
+		const array<float, 2>& factors, const array<bool, 2>& logScales, const array<float, 2>& boxDim) {
+	// The points of an external array are not stored. They are transformed on the fly when they are read
+	if (source.external) {
+		setExternal(source.span);
+		transformedView = true;
+		viewOffsets = offsets;
+		viewFactors = factors;
+		viewLogScales = logScales;
+		viewBoxDim = boxDim;
+		capacity = 0;
+		return;
+	}
+
+	span = ofxGPointSpan();
+	external = false;
+
+	// Use the same storage layout as the source array, so the points can be transformed slot by slot
+	xs.resize(source.xs.size());
+	ys.resize(source.ys.size());
+	valid.resize(source.valid.size());
+	inside.resize(source.inside.size());
+	labels.resize(source.labels.size());
+	head = source.head;
+	count = source.count;
+	capacity = source.capacity;
+	invalidateLimits();
+
+	// Transform the occupied storage slots. They form one or two ranges, depending on the buffer wrap-around
+	size_type storageSize = xs.size();
+	size_type firstEnd = min(head + count, storageSize);
+	transformRange(source, head, firstEnd, offsets, factors, logScales, boxDim);
+
+	if (head + count > storageSize) {
+		transformRange(source, 0, head + count - storageSize, offsets, factors, logScales, boxDim);
+	}
+}
+
+void ofxGPointArray::setTransformed(const ofxGPointArray& source, size_type first, size_type last,
+		const array<float, 2>& offsets, const array<float, 2>& factors, const array<bool, 2>& logScales,
+		const array<float, 2>& boxDim) {
+	// Transform all the points if the storage layouts don't match. This is also the case of the external arrays,
+	// whose transformed view doesn't store any point
+	if (external || source.external || count != source.count || head != source.head || xs.size() != source.xs.size()
+			|| labels.size() != source.labels.size()) {
+		setTransformed(source, offsets, factors, logScales, boxDim);
+		return;
+	}
+
+	invalidateLimits();
+
+	// The points range forms one or two storage ranges, depending on the buffer wrap-around
+	size_type storageSize = xs.size();
+	size_type start = head + first;
+	size_type end = head + last;
+
+	if (first >= last) {
+		return;
+	} else if (end <= storageSize) {
+		transformRange(source, start, end, offsets, factors, logScales, boxDim);
+	} else if (start >= storageSize) {
+		transformRange(source, start - storageSize, end - storageSize, offsets, factors, logScales, boxDim);
+	} else {
+		transformRange(source, start, storageSize, offsets, factors, logScales, boxDim);
+		transformRange(source, 0, end - storageSize, offsets, factors, logScales, boxDim);
+	}
+}
+
+void ofxGPointArray::push_back(float x, float y, const string& label) {
+	if (external) {
+		detach();
+	}
+
+	if (capacity > 0 && count == capacity) {
+		removeFront(1);
+	}
+
+	if (count == xs.size()) {
+		grow();
+	}
+
+	// Update the limits trackers if they are in use
+	if (!limitsNeedUpdate) {
+		bool pointIsValid = isfinite(x) && isfinite(y);
+		sortedByX = sortedByX && !isnan(x) && (count == 0 || x >= xs[physicalIndex(count - 1)]);
+		xLimits.push_back(x, pointIsValid);
+		yLimits.push_back(y, pointIsValid);
+	}
+
+	++count;
+	setSlot(physicalIndex(count - 1), x, y, label);
+}
+
+void ofxGPointArray::push_back(const ofxGPoint& point) {
+	push_back(point.getX(), point.getY(), point.getLabel());
+}
+
+void ofxGPointArray::insert(size_type index, float x, float y, const string& label) {
+	if (external) {
+		detach();
+	}
+
+	if (index == count) {
+		push_back(x, y, label);
+		return;
+	}
+
+	invalidateLimits();
+
+	// Adding a point at the beginning of a full array removes the last point, otherwise the first point is removed
+	if (capacity > 0 && count == capacity) {
+		if (index == 0) {
+			--count;
+		} else {
+			removeFront(1);
+			--index;
+		}
+	}
+
+	if (count == xs.size()) {
+		grow();
+	}
+
+	if (index == 0) {
+		head = (head == 0) ? xs.size() - 1 : head - 1;
+		++count;
+	} else {
+		// Shift the points after the insertion position one slot
+		linearize();
+		move_backward(xs.begin() + index, xs.begin() + count, xs.begin() + count + 1);
+		move_backward(ys.begin() + index, ys.begin() + count, ys.begin() + count + 1);
+		insertBit(valid, index);
+		insertBit(inside, index);
+
+		if (!labels.empty()) {
+			move_backward(labels.begin() + index, labels.begin() + count, labels.begin() + count + 1);
+		}
+
+		++count;
+	}
+
+	setSlot(physicalIndex(index), x, y, label);
+}
+
+void ofxGPointArray::erase(size_type index) {
+	if (external) {
+		detach();
+	}
+
+	if (index == 0) {
+		removeFront(1);
+	} else if (index == count - 1) {
+		--count;
+		invalidateLimits();
+	} else {
+		// Shift the points after the removal position one slot
+		linearize();
+		move(xs.begin() + index + 1, xs.begin() + count, xs.begin() + index);
+		move(ys.begin() + index + 1, ys.begin() + count, ys.begin() + index);
+		eraseBit(valid, index);
+		eraseBit(inside, index);
+
+		if (!labels.empty()) {
+			move(labels.begin() + index + 1, labels.begin() + count, labels.begin() + index);
+		}
+
+		--count;
+		invalidateLimits();
+	}
+}
+
+float ofxGPointArray::getX(size_type index) const {
+	if (external) {
+		return transformedView ? transformX(span.getX(index)) : span.getX(index);
+	}
+
+	return xs[physicalIndex(index)];
+}
+
+float ofxGPointArray::getY(size_type index) const {
+	if (external) {
+		return transformedView ? transformY(span.getY(index)) : span.getY(index);
+	}
+
+	return ys[physicalIndex(index)];
+}
+
+const string& ofxGPointArray::getLabel(size_type index) const {
+	static const string emptyLabel = "";
+
+	return labels.empty() ? emptyLabel : labels[physicalIndex(index)];
+}
+
+bool ofxGPointArray::isValid(size_type index) const {
+	if (external) {
+		// The logarithmic transformation can make a valid span point invalid
+		return span.isValid(index) && (!transformedView || (isfinite(getX(index)) && isfinite(getY(index))));
+	}
+
+	return getBit(valid, physicalIndex(index));
+}
+
+bool ofxGPointArray::isInside(size_type index) const {
+	if (external) {
+		if (!transformedView || !span.isValid(index)) {
+			return false;
+		}
+
+		float x = getX(index);
+		float y = getY(index);
+
+		return x >= 0 && x <= viewBoxDim[0] && y <= 0 && y >= -viewBoxDim[1];
+	}
+
+	return getBit(inside, physicalIndex(index));
+}
+
+bool ofxGPointArray::hasLabels() const {
+	return !labels.empty();
+}
+
+array<float, 2> ofxGPointArray::getXLim(bool positiveOnly) const {
+	if (limitsNeedUpdate) {
+		updateLimitsTrackers();
+	}
+
+	return xLimits.getLim(positiveOnly);
+}
+
+array<float, 2> ofxGPointArray::getYLim(bool positiveOnly) const {
+	if (limitsNeedUpdate) {
+		updateLimitsTrackers();
+	}
+
+	return yLimits.getLim(positiveOnly);
+}
+
+bool ofxGPointArray::isSortedByX() const {
+	if (limitsNeedUpdate) {
+		updateLimitsTrackers();
+	}
+
+	return sortedByX;
+}
+
+ofxGPointArray::size_type ofxGPointArray::lowerBoundX(float value) const {
+	size_type first = 0;
+	size_type n = count;
+
+	while (n > 0) {
+		size_type half = n / 2;
+
+		if (getX(first + half) < value) {
+			first += half + 1;
+			n -= half + 1;
+		} else {
+			n = half;
+		}
+	}
+
+	return first;
+}
+
+ofxGPointArray::size_type ofxGPointArray::upperBoundX(float value) const {
+	size_type first = 0;
+	size_type n = count;
+
+	while (n > 0) {
+		size_type half = n / 2;
+
+		if (getX(first + half) <= value) {
+			first += half + 1;
+			n -= half + 1;
+		} else {
+			n = half;
+		}
+	}
+
+	return first;
+}
+
+ofxGPoint ofxGPointArray::operator[](size_type index) const {
+	if (external) {
+		return ofxGPoint(getX(index), getY(index));
+	}
+
+	size_type pos = physicalIndex(index);
+
+	return ofxGPoint(xs[pos], ys[pos], labels.empty() ? "" : labels[pos]);
+}
+
+ofxGPoint ofxGPointArray::front() const {
+	return (*this)[0];
+}
+
+ofxGPoint ofxGPointArray::back() const {
+	return (*this)[count - 1];
+}
+
+vector<ofxGPoint> ofxGPointArray::toVector() const {
+	vector<ofxGPoint> pts;
+	pts.reserve(count);
+
+	for (size_type i = 0; i < count; ++i) {
+		pts.push_back((*this)[i]);
+	}
+
+	return pts;
+}
+
+ofxGPointArray::const_iterator ofxGPointArray::begin() const {
+	return const_iterator(this, 0);
+}
+
+ofxGPointArray::const_iterator ofxGPointArray::end() const {
+	return const_iterator(this, count);
+}
+
+float ofxGPointArray::transformX(float x) const {
+	return ((viewLogScales[0] ? log10(x) : x) - viewOffsets[0]) * viewFactors[0];
+}
+
+float ofxGPointArray::transformY(float y) const {
+	return ((viewLogScales[1] ? log10(y) : y) - viewOffsets[1]) * viewFactors[1];
+}
+
+ofxGPointArray::size_type ofxGPointArray::physicalIndex(size_type index) const {
+	size_type pos = head + index;
+
+	return (pos < xs.size()) ? pos : pos - xs.size();
+}
+
+void ofxGPointArray::setSlot(size_type pos, float x, float y, const string& label) {
+	xs[pos] = x;
+	ys[pos] = y;
+	setBit(valid, pos, isfinite(x) && isfinite(y));
+	setBit(inside, pos, false);
+
+	if (!labels.empty()) {
+		labels[pos] = label;
+	} else if (label != "") {
+		labels.resize(xs.size());
+		labels[pos] = label;
+	}
+}
+
+void ofxGPointArray::removeFront(size_type n) {
+	if (!limitsNeedUpdate) {
+		if (xLimits.isSlidingWindow()) {
+			for (size_type i = 0; i < n; ++i) {
+				xLimits.pop_front();
+				yLimits.pop_front();
+			}
+		} else {
+			invalidateLimits();
+		}
+	}
+
+	count -= n;
+	head = (count == 0) ? 0 : physicalIndex(n);
+}
+
+void ofxGPointArray::setStorageSize(size_type n) {
+	xs.resize(n, 0);
+	ys.resize(n, 0);
+	valid.resize((n + 63) / 64, 0);
+	inside.resize((n + 63) / 64, 0);
+
+	if (!labels.empty()) {
+		labels.resize(n);
+	}
+}
+
+void ofxGPointArray::grow() {
+	linearize();
+	size_type newSize = max<size_type>(16, 2 * xs.size());
+
+	if (capacity > 0) {
+		newSize = min(newSize, max(capacity, count + 1));
+	}
+
+	setStorageSize(newSize);
+}
+
+void ofxGPointArray::linearize() {
+	if (head == 0) {
+		return;
+	}
+
+	// Rotate the bitmaps copying the bits in the order of the points
+	size_type storageSize = xs.size();
+	vector<uint64_t> newValid(valid.size(), 0);
+	vector<uint64_t> newInside(inside.size(), 0);
+
+	for (size_type i = 0; i < storageSize; ++i) {
+		size_type pos = physicalIndex(i);
+		setBit(newValid, i, getBit(valid, pos));
+		setBit(newInside, i, getBit(inside, pos));
+	}
+
+	valid.swap(newValid);
+	inside.swap(newInside);
+
+	rotate(xs.begin(), xs.begin() + head, xs.end());
+	rotate(ys.begin(), ys.begin() + head, ys.end());
+
+	if (!labels.empty()) {
+		rotate(labels.begin(), labels.begin() + head, labels.end());
+	}
+
+	head = 0;
+}
+
+void ofxGPointArray::invalidateLimits() {
+	if (!limitsNeedUpdate) {
+		xLimits.clear();
+		yLimits.clear();
+		limitsNeedUpdate = true;
+	}
+}
+
+void ofxGPointArray::updateLimitsTrackers() const {
+	// Only the arrays with a fixed capacity remove points from the beginning often enough to need the sliding window
+	// trackers. The rest only keep the current limits
+	bool slidingWindow = capacity > 0 && !external;
+	xLimits.setSlidingWindow(slidingWindow);
+	yLimits.setSlidingWindow(slidingWindow);
+	sortedByX = true;
+
+	float previousX = 0;
+
+	for (size_type i = 0; i < count; ++i) {
+		float x = getX(i);
+		bool pointIsValid = isValid(i);
+		sortedByX = sortedByX && !isnan(x) && (i == 0 || x >= previousX);
+		xLimits.push_back(x, pointIsValid);
+		yLimits.push_back(getY(i), pointIsValid);
+		previousX = x;
+	}
+
+	limitsNeedUpdate = false;
+}
+
+void ofxGPointArray::transformRange(const ofxGPointArray& source, size_type start, size_type end,
+		const array<float, 2>& offsets, const array<float, 2>& factors, const array<bool, 2>& logScales,
+		const array<float, 2>& boxDim) {
+	// Process the slots in blocks of 64, so each block fills exactly one bitmap word
+	float xLogValues[64];
+	float yLogValues[64];
+	float xSpanValues[64];
+	float ySpanValues[64];
+
+	for (size_type blockStart = start - start % 64; blockStart < end; blockStart += 64) {
+		size_type blockSize = min<size_type>(64, xs.size() - blockStart);
+		const float* xValues;
+		const float* yValues;
+
+		// The span points are copied to contiguous blocks first, because they can be interleaved
+		if (source.external) {
+			source.span.copyTo(blockStart, blockSize, xSpanValues, ySpanValues);
+			xValues = xSpanValues;
+			yValues = ySpanValues;
+		} else {
+			xValues = source.xs.data() + blockStart;
+			yValues = source.ys.data() + blockStart;
+		}
+
+		if (logScales[0]) {
+			for (size_type i = 0; i < blockSize; ++i) {
+				xLogValues[i] = log10(xValues[i]);
+			}
+
+			xValues = xLogValues;
+		}
+
+		if (logScales[1]) {
+			for (size_type i = 0; i < blockSize; ++i) {
+				yLogValues[i] = log10(yValues[i]);
+			}
+
+			yValues = yLogValues;
+		}
+
+		transformBlock(xValues, yValues, blockSize, offsets, factors, boxDim, xs.data() + blockStart,
+				ys.data() + blockStart, valid[blockStart / 64], inside[blockStart / 64]);
+	}
+
+	// The labels are not transformed, only copied
+	if (!labels.empty()) {
+		copy(source.labels.begin() + start, source.labels.begin() + end, labels.begin() + start);
+	}
+}
+
+void ofxGPointArray::transformBlock(const float* xValues, const float* yValues, size_type n,
+		const array<float, 2>& offsets, const array<float, 2>& factors, const array<float, 2>& boxDim, float* xResult,
+		float* yResult, uint64_t& validBits, uint64_t& insideBits) {
+	validBits = 0;
+	insideBits = 0;
+	size_type i = 0;
+
+	// A coordinate is finite if subtracting it from itself gives zero (NaN otherwise). The range comparisons are
+	// always false for NaN values, so the inside bits never include invalid points
+#if defined(OFXG_USE_AVX2)
+	const __m256 xOffset = _mm256_set1_ps(offsets[0]);
+	const __m256 yOffset = _mm256_set1_ps(offsets[1]);
+	const __m256 xFactor = _mm256_set1_ps(factors[0]);
+	const __m256 yFactor = _mm256_set1_ps(factors[1]);
+	const __m256 xMax = _mm256_set1_ps(boxDim[0]);
+	const __m256 yMin = _mm256_set1_ps(-boxDim[1]);
+	const __m256 zero = _mm256_setzero_ps();
+
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(xValues + i), xOffset), xFactor);
+		__m256 y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(yValues + i), yOffset), yFactor);
+		_mm256_storeu_ps(xResult + i, x);
+		_mm256_storeu_ps(yResult + i, y);
+
+		__m256 validMask = _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(x, x), zero, _CMP_EQ_OQ),
+				_mm256_cmp_ps(_mm256_sub_ps(y, y), zero, _CMP_EQ_OQ));
+		__m256 insideMask = _mm256_and_ps(
+				_mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_GE_OQ), _mm256_cmp_ps(x, xMax, _CMP_LE_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(y, zero, _CMP_LE_OQ), _mm256_cmp_ps(y, yMin, _CMP_GE_OQ)));
+		validBits |= uint64_t(_mm256_movemask_ps(validMask)) << i;
+		insideBits |= uint64_t(_mm256_movemask_ps(insideMask)) << i;
+	}
+#elif defined(OFXG_USE_SSE2)
+	const __m128 xOffset = _mm_set1_ps(offsets[0]);
+	const __m128 yOffset = _mm_set1_ps(offsets[1]);
+	const __m128 xFactor = _mm_set1_ps(factors[0]);
+	const __m128 yFactor = _mm_set1_ps(factors[1]);
+	const __m128 xMax = _mm_set1_ps(boxDim[0]);
+	const __m128 yMin = _mm_set1_ps(-boxDim[1]);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(xValues + i), xOffset), xFactor);
+		__m128 y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(yValues + i), yOffset), yFactor);
+		_mm_storeu_ps(xResult + i, x);
+		_mm_storeu_ps(yResult + i, y);
+
+		__m128 validMask = _mm_and_ps(_mm_cmpeq_ps(_mm_sub_ps(x, x), zero), _mm_cmpeq_ps(_mm_sub_ps(y, y), zero));
+		__m128 insideMask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, zero), _mm_cmple_ps(x, xMax)),
+				_mm_and_ps(_mm_cmple_ps(y, zero), _mm_cmpge_ps(y, yMin)));
+		validBits |= uint64_t(_mm_movemask_ps(validMask)) << i;
+		insideBits |= uint64_t(_mm_movemask_ps(insideMask)) << i;
+	}
+#elif defined(OFXG_USE_NEON)
+	const float32x4_t xOffset = vdupq_n_f32(offsets[0]);
+	const float32x4_t yOffset = vdupq_n_f32(offsets[1]);
+	const float32x4_t xFactor = vdupq_n_f32(factors[0]);
+	const float32x4_t yFactor = vdupq_n_f32(factors[1]);
+	const float32x4_t xMax = vdupq_n_f32(boxDim[0]);
+	const float32x4_t yMin = vdupq_n_f32(-boxDim[1]);
+	const float32x4_t zero = vdupq_n_f32(0);
+	const uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+	const uint32x4_t laneBits = vld1q_u32(laneBitsData);
+
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vmulq_f32(vsubq_f32(vld1q_f32(xValues + i), xOffset), xFactor);
+		float32x4_t y = vmulq_f32(vsubq_f32(vld1q_f32(yValues + i), yOffset), yFactor);
+		vst1q_f32(xResult + i, x);
+		vst1q_f32(yResult + i, y);
+
+		uint32x4_t validMask = vandq_u32(vceqq_f32(vsubq_f32(x, x), zero), vceqq_f32(vsubq_f32(y, y), zero));
+		uint32x4_t insideMask = vandq_u32(vandq_u32(vcgeq_f32(x, zero), vcleq_f32(x, xMax)),
+				vandq_u32(vcleq_f32(y, zero), vcgeq_f32(y, yMin)));
+
+		// Collapse the lane masks into 4 bits
+		uint32x4_t validLanes = vandq_u32(validMask, laneBits);
+		uint32x4_t insideLanes = vandq_u32(insideMask, laneBits);
+		uint32x2_t validSum = vadd_u32(vget_low_u32(validLanes), vget_high_u32(validLanes));
+		uint32x2_t insideSum = vadd_u32(vget_low_u32(insideLanes), vget_high_u32(insideLanes));
+		validBits |= uint64_t(vget_lane_u32(vpadd_u32(validSum, validSum), 0)) << i;
+		insideBits |= uint64_t(vget_lane_u32(vpadd_u32(insideSum, insideSum), 0)) << i;
+	}
+#endif
+
+	for (; i < n; ++i) {
+		float x = (xValues[i] - offsets[0]) * factors[0];
+		float y = (yValues[i] - offsets[1]) * factors[1];
+		xResult[i] = x;
+		yResult[i] = y;
+
+		if (x - x == 0 && y - y == 0) {
+			validBits |= uint64_t(1) << i;
+		}
+
+		if (x >= 0 && x <= boxDim[0] && y <= 0 && y >= -boxDim[1]) {
+			insideBits |= uint64_t(1) << i;
+		}
+	}
+}
+
+bool ofxGPointArray::getBit(const vector<uint64_t>& bits, size_type index) {
+	return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+void ofxGPointArray::setBit(vector<uint64_t>& bits, size_type index, bool value) {
+	uint64_t mask = uint64_t(1) << (index % 64);
+
+	if (value) {
+		bits[index / 64] |= mask;
+	} else {
+		bits[index / 64] &= ~mask;
+	}
+}
+
+void ofxGPointArray::insertBit(vector<uint64_t>& bits, size_type index) {
+	// Shift the words after the insertion word one bit to the left
+	size_type word = index / 64;
+
+	for (size_type w = bits.size() - 1; w > word; --w) {
+		bits[w] = (bits[w] << 1) | (bits[w - 1] >> 63);
+	}
+
+	// Shift the bits above the insertion position inside the insertion word
+	uint64_t lowMask = (uint64_t(1) << (index % 64)) - 1;
+	bits[word] = (bits[word] & lowMask) | ((bits[word] & ~lowMask) << 1);
+}
+
+void ofxGPointArray::eraseBit(vector<uint64_t>& bits, size_type index) {
+	// Shift the bits above the removal position inside the removal word
+	size_type word = index / 64;
+	uint64_t lowMask = (uint64_t(1) << (index % 64)) - 1;
+	bits[word] = (bits[word] & lowMask) | ((bits[word] >> 1) & ~lowMask);
+
+	// Shift the words after the removal word one bit to the right
+	for (size_type w = word + 1; w < bits.size(); ++w) {
+		bits[w - 1] |= bits[w] << 63;
+		bits[w] >>= 1;
+	}
+}
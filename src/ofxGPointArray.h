@@ -0,0 +1,701 @@
+#pragma once
+
+#include "ofxGPoint.h"
+#include "ofxGLimitsTracker.h"
+#include "ofxGPointSpan.h"
+#include "ofMain.h"
+
+/**
+ * @brief Point array class
+ *
+ * An ofxGPointArray stores a set of points in columnar form: two contiguous arrays with the x and y coordinates, a
+ * packed bitmap with the points validity, a packed bitmap that indicates if the points are inside the plot box and an
+ * optional column with the point labels. The label column is only allocated when at least one of the points has a
+ * non-empty label.
+ *
+ * The columns are used as a circular buffer, so adding or removing points at the beginning or the end of the array
+ * doesn't move the rest of the points. The array can also have a fixed capacity. In that case, adding a point to a full
+ * array removes the oldest point.
+ *
+ * The array also keeps the limits of its valid points. They are recalculated lazily after arbitrary modifications,
+ * and updated in constant time when the points are only added at the end. Arrays with a fixed capacity also update
+ * them in constant time when the oldest points are removed.
+ *
+ * The array can also be a read-only view of points stored in caller-owned memory (an ofxGPointSpan). In that case the
+ * columns are not allocated: the coordinates are read directly from the span, the points have no labels and the
+ * capacity is not applied. Modifying the points of an external array copies them to the array storage first. The
+ * transformed points of an external array are also a view of the same span, which applies the transformation when
+ * the points are read.
+ *
+ * The ofxGPoint interface is kept as a facade: the elements can be read as ofxGPoint copies, and the array can be
+ * iterated with a range-based for loop.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGPointArray {
+public:
+
+	/**
+	 * @brief The array size type
+	 */
+	typedef vector<float>::size_type size_type;
+
+	/**
+	 * @brief Iterator that returns ofxGPoint copies of the array elements
+	 */
+	class const_iterator {
+	public:
+
+		/**
+		 * @brief Constructor
+		 *
+		 * @param _arr the point array
+		 * @param _index the element position
+		 */
+		const_iterator(const ofxGPointArray* _arr, size_type _index) :
+				arr(_arr), index(_index) {
+		}
+
+		/**
+		 * @brief Returns a copy of the current element
+		 *
+		 * @return a copy of the current element
+		 */
+		ofxGPoint operator*() const {
+			return (*arr)[index];
+		}
+
+		/**
+		 * @brief Moves the iterator to the next element
+		 *
+		 * @return the iterator
+		 */
+		const_iterator& operator++() {
+			++index;
+			return *this;
+		}
+
+		/**
+		 * @brief Checks if two iterators point to the same element
+		 *
+		 * @param other the iterator to compare with
+		 *
+		 * @return true if the two iterators point to the same element
+		 */
+		bool operator==(const const_iterator& other) const {
+			return index == other.index && arr == other.arr;
+		}
+
+		/**
+		 * @brief Checks if two iterators point to different elements
+		 *
+		 * @param other the iterator to compare with
+		 *
+		 * @return true if the two iterators point to different elements
+		 */
+		bool operator!=(const const_iterator& other) const {
+			return !(*this == other);
+		}
+
+	protected:
+
+		/**
+		 * @brief The point array
+		 */
+		const ofxGPointArray* arr;
+
+		/**
+		 * @brief The element position
+		 */
+		size_type index;
+	};
+
+	/**
+	 * @brief Default constructor
+	 */
+	ofxGPointArray();
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param pts the initial points
+	 */
+	ofxGPointArray(const vector<ofxGPoint>& pts);
+
+	/**
+	 * @brief Returns the number of points in the array
+	 *
+	 * @return the number of points in the array
+	 */
+	size_type size() const;
+
+	/**
+	 * @brief Checks if the array is empty
+	 *
+	 * @return true if the array has no points
+	 */
+	bool empty() const;
+
+	/**
+	 * @brief Removes all the points from the array
+	 */
+	void clear();
+
+	/**
+	 * @brief Reserves memory for a given number of points
+	 *
+	 * @param n the number of points
+	 */
+	void reserve(size_type n);
+
+	/**
+	 * @brief Changes the number of points in the array. New points are set to (0, 0) and have no label
+	 *
+	 * @param n the new number of points
+	 */
+	void resize(size_type n);
+
+	/**
+	 * @brief Sets the maximum number of points that the array can contain
+	 *
+	 * When the array is full, adding a point at the end or in the middle of the array removes the first point, and adding
+	 * a point at the beginning of the array removes the last point. If the array has more points than the new capacity,
+	 * the first points are removed.
+	 *
+	 * @param newCapacity the maximum number of points. Use 0 for no limit
+	 */
+	void setCapacity(size_type newCapacity);
+
+	/**
+	 * @brief Returns the maximum number of points that the array can contain
+	 *
+	 * @return the maximum number of points. 0 means no limit
+	 */
+	size_type getCapacity() const;
+
+	/**
+	 * @brief Replaces the array content with a set of points. If the array has a fixed capacity, only the last points
+	 * are kept
+	 *
+	 * @param pts the new points
+	 */
+	void set(const vector<ofxGPoint>& pts);
+
+	/**
+	 * @brief Replaces the array content with a copy of the points in a span and their labels. If the array has a fixed
+	 * capacity, only the last points are kept
+	 *
+	 * @param pts the span with the new points
+	 * @param newLabels the point labels. It should be empty or have one label per point
+	 */
+	void set(const ofxGPointSpan& pts, const vector<string>& newLabels);
+
+	/**
+	 * @brief Makes the array a view of the points in a span. The points are not copied
+	 *
+	 * @param newSpan the span with the points. Its memory should stay valid while the array uses it
+	 */
+	void setExternal(const ofxGPointSpan& newSpan);
+
+	/**
+	 * @brief Checks if the array is a view of the points in a span
+	 *
+	 * @return true if the array points are read from a span
+	 */
+	bool isExternal() const;
+
+	/**
+	 * @brief Copies the points of the span to the array storage, so they can be modified. If the array has a fixed
+	 * capacity, only the last points are kept
+	 */
+	void detach();
+
+	/**
+	 * @brief Informs the array that the values of the span points changed, so its limits should be recalculated
+	 */
+	void markDirty();
+
+	/**
+	 * @brief Sets the coordinates and the label of one of the points
+	 *
+	 * @param index the point position
+	 * @param x the new x coordinate
+	 * @param y the new y coordinate
+	 * @param label the new label
+	 */
+	void set(size_type index, float x, float y, const string& label);
+
+	/**
+	 * @brief Sets the coordinates of one of the points. The label is not modified
+	 *
+	 * @param index the point position
+	 * @param x the new x coordinate
+	 * @param y the new y coordinate
+	 */
+	void setXY(size_type index, float x, float y);
+
+	/**
+	 * @brief Sets the label of one of the points
+	 *
+	 * @param index the point position
+	 * @param label the new label
+	 */
+	void setLabel(size_type index, const string& label);
+
+	/**
+	 * @brief Sets if one of the points is inside the plot box or not
+	 *
+	 * @param index the point position
+	 * @param inside true if the point is inside the plot box
+	 */
+	void setInside(size_type index, bool inside);
+
+	/**
+	 * @brief Sets the array coordinates to the transformed coordinates of a given set of points and updates in the
+	 * same pass the bitmap that indicates if the points are inside the plot box
+	 *
+	 * The transformed x coordinate is calculated as (x - offsets[0]) * factors[0], where x is replaced by log10(x) if
+	 * the scale is logarithmic, and the same for the y coordinate. A point is inside if its transformed coordinates
+	 * fall inside the [0, boxDim[0]] x [-boxDim[1], 0] region. The labels are copied from the source.
+	 *
+	 * If the source is external, the array becomes a view of the source span that transforms the points when they are
+	 * read, so the transformed points are never stored.
+	 *
+	 * @param source the points to transform. The array adopts its number of points, capacity and storage layout
+	 * @param offsets the x and y offsets
+	 * @param factors the x and y scaling factors
+	 * @param logScales defines if the x and y scales are logarithmic or not
+	 * @param boxDim the plot box dimensions
+	 */
+	void setTransformed(const ofxGPointArray& source, const array<float, 2>& offsets, const array<float, 2>& factors,
+			const array<bool, 2>& logScales, const array<float, 2>& boxDim);
+
+	/**
+	 * @brief Recalculates the transformed coordinates of a range of points
+	 *
+	 * The array should contain the transformed points of the same source, calculated with setTransformed. If the
+	 * number of points or the storage layout changed since then, all the points are transformed.
+	 *
+	 * @param source the points to transform
+	 * @param first the position of the first point to transform
+	 * @param last the position after the last point to transform
+	 * @param offsets the x and y offsets
+	 * @param factors the x and y scaling factors
+	 * @param logScales defines if the x and y scales are logarithmic or not
+	 * @param boxDim the plot box dimensions
+	 */
+	void setTransformed(const ofxGPointArray& source, size_type first, size_type last, const array<float, 2>& offsets,
+			const array<float, 2>& factors, const array<bool, 2>& logScales, const array<float, 2>& boxDim);
+
+	/**
+	 * @brief Adds a point at the end of the array
+	 *
+	 * @param x the point x coordinate
+	 * @param y the point y coordinate
+	 * @param label the point label
+	 */
+	void push_back(float x, float y, const string& label = "");
+
+	/**
+	 * @brief Adds a point at the end of the array
+	 *
+	 * @param point the point to add
+	 */
+	void push_back(const ofxGPoint& point);
+
+	/**
+	 * @brief Inserts a point at a given position
+	 *
+	 * @param index the position to insert the point
+	 * @param x the point x coordinate
+	 * @param y the point y coordinate
+	 * @param label the point label
+	 */
+	void insert(size_type index, float x, float y, const string& label = "");
+
+	/**
+	 * @brief Removes one of the points
+	 *
+	 * @param index the point position
+	 */
+	void erase(size_type index);
+
+	/**
+	 * @brief Returns the x coordinate of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return the point x coordinate
+	 */
+	float getX(size_type index) const;
+
+	/**
+	 * @brief Returns the y coordinate of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return the point y coordinate
+	 */
+	float getY(size_type index) const;
+
+	/**
+	 * @brief Returns the label of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return the point label
+	 */
+	const string& getLabel(size_type index) const;
+
+	/**
+	 * @brief Returns if the coordinates of one of the points are valid or not
+	 *
+	 * @param index the point position
+	 *
+	 * @return true if the point coordinates are valid
+	 */
+	bool isValid(size_type index) const;
+
+	/**
+	 * @brief Returns if one of the points is inside the plot box or not
+	 *
+	 * @param index the point position
+	 *
+	 * @return true if the point is inside the plot box
+	 */
+	bool isInside(size_type index) const;
+
+	/**
+	 * @brief Checks if any of the points has a label
+	 *
+	 * @return true if the array contains a label column
+	 */
+	bool hasLabels() const;
+
+	/**
+	 * @brief Returns the minimum and maximum x coordinates of the valid points
+	 *
+	 * @param positiveOnly true if only the points with a positive x coordinate should be considered
+	 *
+	 * @return the minimum and maximum x coordinates. It will return {infinity, -infinity} if there are no valid points
+	 */
+	array<float, 2> getXLim(bool positiveOnly) const;
+
+	/**
+	 * @brief Returns the minimum and maximum y coordinates of the valid points
+	 *
+	 * @param positiveOnly true if only the points with a positive y coordinate should be considered
+	 *
+	 * @return the minimum and maximum y coordinates. It will return {infinity, -infinity} if there are no valid points
+	 */
+	array<float, 2> getYLim(bool positiveOnly) const;
+
+	/**
+	 * @brief Checks if the points are sorted by their x coordinate (with no NaN values)
+	 *
+	 * @return true if the points are sorted by their x coordinate
+	 */
+	bool isSortedByX() const;
+
+	/**
+	 * @brief Returns the position of the first point with an x coordinate that is not smaller than a given value. The
+	 * points should be sorted by their x coordinate
+	 *
+	 * @param value the x value
+	 *
+	 * @return the point position
+	 */
+	size_type lowerBoundX(float value) const;
+
+	/**
+	 * @brief Returns the position of the first point with an x coordinate larger than a given value. The points should
+	 * be sorted by their x coordinate
+	 *
+	 * @param value the x value
+	 *
+	 * @return the point position
+	 */
+	size_type upperBoundX(float value) const;
+
+	/**
+	 * @brief Returns a copy of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return a copy of the point
+	 */
+	ofxGPoint operator[](size_type index) const;
+
+	/**
+	 * @brief Returns a copy of the first point
+	 *
+	 * @return a copy of the first point
+	 */
+	ofxGPoint front() const;
+
+	/**
+	 * @brief Returns a copy of the last point
+	 *
+	 * @return a copy of the last point
+	 */
+	ofxGPoint back() const;
+
+	/**
+	 * @brief Returns the array content as a vector of points
+	 *
+	 * @return a vector with copies of the points
+	 */
+	vector<ofxGPoint> toVector() const;
+
+	/**
+	 * @brief Returns an iterator to the first point
+	 *
+	 * @return an iterator to the first point
+	 */
+	const_iterator begin() const;
+
+	/**
+	 * @brief Returns an iterator past the last point
+	 *
+	 * @return an iterator past the last point
+	 */
+	const_iterator end() const;
+
+protected:
+
+	/**
+	 * @brief Applies the transformation of a transformed view to an x coordinate
+	 *
+	 * @param x the x coordinate
+	 *
+	 * @return the transformed x coordinate
+	 */
+	float transformX(float x) const;
+
+	/**
+	 * @brief Applies the transformation of a transformed view to a y coordinate
+	 *
+	 * @param y the y coordinate
+	 *
+	 * @return the transformed y coordinate
+	 */
+	float transformY(float y) const;
+
+	/**
+	 * @brief Returns the storage slot of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return the point storage slot
+	 */
+	size_type physicalIndex(size_type index) const;
+
+	/**
+	 * @brief Writes a point in a storage slot. The point is marked as not inside the plot box
+	 *
+	 * @param pos the storage slot
+	 * @param x the point x coordinate
+	 * @param y the point y coordinate
+	 * @param label the point label
+	 */
+	void setSlot(size_type pos, float x, float y, const string& label);
+
+	/**
+	 * @brief Removes some points from the beginning of the array
+	 *
+	 * @param n the number of points to remove
+	 */
+	void removeFront(size_type n);
+
+	/**
+	 * @brief Changes the number of storage slots. It should only be called when the buffer is not wrapped
+	 *
+	 * @param n the new number of storage slots
+	 */
+	void setStorageSize(size_type n);
+
+	/**
+	 * @brief Increases the number of storage slots
+	 */
+	void grow();
+
+	/**
+	 * @brief Moves the points in the storage slots so the first point is in the first slot
+	 */
+	void linearize();
+
+	/**
+	 * @brief Marks the limits trackers as outdated and releases their content
+	 */
+	void invalidateLimits();
+
+	/**
+	 * @brief Recalculates the limits trackers and the sorting state from all the points
+	 */
+	void updateLimitsTrackers() const;
+
+	/**
+	 * @brief Transforms the points in a range of storage slots of a given array and copies their labels
+	 *
+	 * @param source the array with the points to transform. It should have the same storage layout, or be external
+	 * @param start the first storage slot
+	 * @param end the storage slot after the last one
+	 * @param offsets the x and y offsets
+	 * @param factors the x and y scaling factors
+	 * @param logScales defines if the x and y scales are logarithmic or not
+	 * @param boxDim the plot box dimensions
+	 */
+	void transformRange(const ofxGPointArray& source, size_type start, size_type end, const array<float, 2>& offsets,
+			const array<float, 2>& factors, const array<bool, 2>& logScales, const array<float, 2>& boxDim);
+
+	/**
+	 * @brief Transforms a block of up to 64 points and calculates their validity and inside bitmaps
+	 *
+	 * It uses AVX2, SSE2 or NEON instructions when they are available, and a scalar loop for the remaining points.
+	 *
+	 * @param xValues the points x coordinates (already in logarithmic form if needed)
+	 * @param yValues the points y coordinates (already in logarithmic form if needed)
+	 * @param n the number of points in the block. It should be equal or smaller than 64
+	 * @param offsets the x and y offsets
+	 * @param factors the x and y scaling factors
+	 * @param boxDim the plot box dimensions
+	 * @param xResult the array where the transformed x coordinates will be written
+	 * @param yResult the array where the transformed y coordinates will be written
+	 * @param validBits the word where the validity bits will be written
+	 * @param insideBits the word where the inside bits will be written
+	 */
+	static void transformBlock(const float* xValues, const float* yValues, size_type n, const array<float, 2>& offsets,
+			const array<float, 2>& factors, const array<float, 2>& boxDim, float* xResult, float* yResult,
+			uint64_t& validBits, uint64_t& insideBits);
+
+	/**
+	 * @brief Returns the value of a bit in a packed bitmap
+	 *
+	 * @param bits the packed bitmap
+	 * @param index the bit position
+	 *
+	 * @return the bit value
+	 */
+	static bool getBit(const vector<uint64_t>& bits, size_type index);
+
+	/**
+	 * @brief Sets the value of a bit in a packed bitmap
+	 *
+	 * @param bits the packed bitmap
+	 * @param index the bit position
+	 * @param value the new bit value
+	 */
+	static void setBit(vector<uint64_t>& bits, size_type index, bool value);
+
+	/**
+	 * @brief Opens a gap in a packed bitmap at a given position, shifting the following bits one position. The last
+	 * bit of the bitmap is lost
+	 *
+	 * @param bits the packed bitmap
+	 * @param index the bit position
+	 */
+	static void insertBit(vector<uint64_t>& bits, size_type index);
+
+	/**
+	 * @brief Removes a bit from a packed bitmap, shifting the following bits one position
+	 *
+	 * @param bits the packed bitmap
+	 * @param index the bit position
+	 */
+	static void eraseBit(vector<uint64_t>& bits, size_type index);
+
+	/**
+	 * @brief The storage slot of the first point
+	 */
+	size_type head;
+
+	/**
+	 * @brief The number of points in the array
+	 */
+	size_type count;
+
+	/**
+	 * @brief The maximum number of points in the array. 0 means no limit
+	 */
+	size_type capacity;
+
+	/**
+	 * @brief The points x coordinates
+	 */
+	vector<float> xs;
+
+	/**
+	 * @brief The points y coordinates
+	 */
+	vector<float> ys;
+
+	/**
+	 * @brief Packed bitmap that defines if the points coordinates are valid or not
+	 */
+	vector<uint64_t> valid;
+
+	/**
+	 * @brief Packed bitmap that defines if the points are inside the plot box or not
+	 */
+	vector<uint64_t> inside;
+
+	/**
+	 * @brief The points labels. It's empty if none of the points has a label
+	 */
+	vector<string> labels;
+
+	/**
+	 * @brief The x coordinates limits tracker
+	 */
+	mutable ofxGLimitsTracker xLimits;
+
+	/**
+	 * @brief The y coordinates limits tracker
+	 */
+	mutable ofxGLimitsTracker yLimits;
+
+	/**
+	 * @brief Defines if the points are sorted by their x coordinate
+	 */
+	mutable bool sortedByX;
+
+	/**
+	 * @brief Defines if the limits trackers should be recalculated before using them
+	 */
+	mutable bool limitsNeedUpdate;
+
+	/**
+	 * @brief The span with the points, if the array is external
+	 */
+	ofxGPointSpan span;
+
+	/**
+	 * @brief Defines if the array points are read from the span
+	 */
+	bool external;
+
+	/**
+	 * @brief Defines if the span points are transformed when they are read
+	 */
+	bool transformedView;
+
+	/**
+	 * @brief The x and y offsets of the transformed view
+	 */
+	array<float, 2> viewOffsets;
+
+	/**
+	 * @brief The x and y scaling factors of the transformed view
+	 */
+	array<float, 2> viewFactors;
+
+	/**
+	 * @brief Defines if the x and y scales of the transformed view are logarithmic or not
+	 */
+	array<bool, 2> viewLogScales;
+
+	/**
+	 * @brief The plot box dimensions of the transformed view
+	 */
+	array<float, 2> viewBoxDim;
+};
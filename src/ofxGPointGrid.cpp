@@ -0,0 +1,84 @@
+#include "ofxGPointGrid.h"
+#include "ofxGPointArray.h"
+#include "ofMain.h"
+
+ofxGPointGrid::ofxGPointGrid() :
+		cellSize(1), nCols(0), nRows(0) {
+}
+
+void ofxGPointGrid::build(const ofxGPointArray& plotPoints, const vector<ofxGPointArray::size_type>* indices,
+		const array<float, 2>& dim, float newCellSize) {
+	// Limit the number of cells per side
+	cellSize = max(newCellSize, max(dim[0], dim[1]) / 1024);
+	nCols = int(dim[0] / cellSize) + 1;
+	nRows = int(dim[1] / cellSize) + 1;
+	cellStarts.assign(nCols * nRows + 1, 0);
+
+	// Count the number of points in each cell. The y coordinate is negative inside the plot box
+	ofxGPointArray::size_type nPoints = indices ? indices->size() : plotPoints.size();
+	ofxGPointArray::size_type nPointsInside = 0;
+
+	for (ofxGPointArray::size_type k = 0; k < nPoints; ++k) {
+		ofxGPointArray::size_type i = indices ? (*indices)[k] : k;
+
+		if (plotPoints.isInside(i)) {
+			int col = int(plotPoints.getX(i) / cellSize);
+			int row = int(-plotPoints.getY(i) / cellSize);
+			++cellStarts[row * nCols + col + 1];
+			++nPointsInside;
+		}
+	}
+
+	for (vector<ofxGPointArray::size_type>::size_type i = 1; i < cellStarts.size(); ++i) {
+		cellStarts[i] += cellStarts[i - 1];
+	}
+
+	// Fill the cells keeping the points order
+	vector<ofxGPointArray::size_type> cellCounters(cellStarts.begin(), cellStarts.end() - 1);
+	pointIndices.resize(nPointsInside);
+
+	for (ofxGPointArray::size_type k = 0; k < nPoints; ++k) {
+		ofxGPointArray::size_type i = indices ? (*indices)[k] : k;
+
+		if (plotPoints.isInside(i)) {
+			int col = int(plotPoints.getX(i) / cellSize);
+			int row = int(-plotPoints.getY(i) / cellSize);
+			pointIndices[cellCounters[row * nCols + col]++] = i;
+		}
+	}
+}
+
+ofxGPointArray::size_type ofxGPointGrid::findClosest(const ofxGPointArray& plotPoints, float xPlot, float yPlot,
+		const vector<float>& pointSizes, float minRadius) const {
+	ofxGPointArray::size_type pointIndex = plotPoints.size();
+	float minDistSq = 1000000;
+	float minRadiusSq = minRadius * minRadius;
+	int nSizes = pointSizes.size();
+
+	// Check the cell that contains the position and its neighbours
+	int col = int(floor(xPlot / cellSize));
+	int row = int(floor(-yPlot / cellSize));
+
+	for (int r = max(row - 1, 0); r <= min(row + 1, nRows - 1); ++r) {
+		for (int c = max(col - 1, 0); c <= min(col + 1, nCols - 1); ++c) {
+			int cell = r * nCols + c;
+
+			for (ofxGPointArray::size_type j = cellStarts[cell]; j < cellStarts[cell + 1]; ++j) {
+				ofxGPointArray::size_type i = pointIndices[j];
+				float deltaX = plotPoints.getX(i) - xPlot;
+				float deltaY = plotPoints.getY(i) - yPlot;
+				float distSq = deltaX * deltaX + deltaY * deltaY;
+				float pointSize = pointSizes[i % nSizes];
+
+				// In case of a tie, select the first point
+				if (distSq < max(pointSize * pointSize, minRadiusSq)
+						&& (distSq < minDistSq || (distSq == minDistSq && i < pointIndex))) {
+					minDistSq = distSq;
+					pointIndex = i;
+				}
+			}
+		}
+	}
+
+	return pointIndex;
+}
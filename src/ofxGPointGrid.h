@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ofxGPointArray.h"
+#include "ofMain.h"
+
+/**
+ * @brief Point grid class
+ *
+ * An ofxGPointGrid is a uniform grid spatial index over the points that are inside the plot box. Each grid cell stores
+ * the positions of the points that fall on it, so the points close to a given position can be found checking only the
+ * neighbouring cells.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGPointGrid {
+public:
+
+	/**
+	 * @brief Constructor
+	 */
+	ofxGPointGrid();
+
+	/**
+	 * @brief Builds the grid from a set of points in the plot reference system
+	 *
+	 * @param plotPoints the points in the plot reference system. Only the points inside the plot box are indexed
+	 * @param indices the positions of the points to index. All the points are considered if it's a null pointer
+	 * @param dim the plot box dimensions
+	 * @param newCellSize the grid cell size. It should not be smaller than the maximum search radius. It will be
+	 * increased if necessary to limit the grid to 1024 cells per side
+	 */
+	void build(const ofxGPointArray& plotPoints, const vector<ofxGPointArray::size_type>* indices,
+			const array<float, 2>& dim, float newCellSize);
+
+	/**
+	 * @brief Returns the position of the closest point to a given plot position, within the point size
+	 *
+	 * A point is a candidate if its distance to the plot position is smaller than its point size, or than the minimum
+	 * radius if the point size is smaller. The point sizes and the minimum radius should not be larger than the grid
+	 * cell size.
+	 *
+	 * @param plotPoints the points used to build the grid
+	 * @param xPlot x position in the plot reference system
+	 * @param yPlot y position in the plot reference system
+	 * @param pointSizes the point sizes. They are applied cyclically to the points
+	 * @param minRadius the minimum search radius
+	 *
+	 * @return the position of the closest point. It will be equal to plotPoints.size() if there is no point close
+	 * enough
+	 */
+	ofxGPointArray::size_type findClosest(const ofxGPointArray& plotPoints, float xPlot, float yPlot,
+			const vector<float>& pointSizes, float minRadius) const;
+
+protected:
+
+	/**
+	 * @brief The grid cell size
+	 */
+	float cellSize;
+
+	/**
+	 * @brief The number of grid columns
+	 */
+	int nCols;
+
+	/**
+	 * @brief The number of grid rows
+	 */
+	int nRows;
+
+	/**
+	 * @brief The position in the pointIndices array of the first point of each cell. It has one extra element with the
+	 * total number of indexed points
+	 */
+	vector<ofxGPointArray::size_type> cellStarts;
+
+	/**
+	 * @brief The indexed point positions, ordered by cell
+	 */
+	vector<ofxGPointArray::size_type> pointIndices;
+};
@@ -0,0 +1,69 @@
+#include "ofxGPointSpan.h"
+#include "ofMain.h"
+
+ofxGPointSpan::ofxGPointSpan() :
+		xs(nullptr), ys(nullptr), count(0), stride(sizeof(float)), validMask(nullptr) {
+}
+
+ofxGPointSpan::ofxGPointSpan(const float* _xs, const float* _ys, size_t _count, size_t _stride,
+		const uint8_t* _validMask) :
+		xs(reinterpret_cast<const uint8_t*>(_xs)), ys(reinterpret_cast<const uint8_t*>(_ys)), count(_count),
+		stride(_stride), validMask(_validMask) {
+	// Check that the span makes sense
+	if (count > 0 && (_xs == nullptr || _ys == nullptr)) {
+		throw invalid_argument("The coordinate pointers should not be null.");
+	} else if (stride < sizeof(float)) {
+		throw invalid_argument("The stride should be at least the size of one coordinate.");
+	}
+}
+
+void ofxGPointSpan::setOwner(const shared_ptr<const void>& newOwner) {
+	owner = newOwner;
+}
+
+size_t ofxGPointSpan::size() const {
+	return count;
+}
+
+bool ofxGPointSpan::empty() const {
+	return count == 0;
+}
+
+float ofxGPointSpan::getX(size_t index) const {
+	float x;
+	memcpy(&x, xs + index * stride, sizeof(float));
+
+	return x;
+}
+
+float ofxGPointSpan::getY(size_t index) const {
+	float y;
+	memcpy(&y, ys + index * stride, sizeof(float));
+
+	return y;
+}
+
+bool ofxGPointSpan::isValid(size_t index) const {
+	return (validMask == nullptr || validMask[index] != 0) && isfinite(getX(index)) && isfinite(getY(index));
+}
+
+void ofxGPointSpan::copyTo(size_t first, size_t n, float* xResult, float* yResult) const {
+	// Contiguous columns can be copied in one go
+	if (stride == sizeof(float)) {
+		memcpy(xResult, xs + first * stride, n * sizeof(float));
+		memcpy(yResult, ys + first * stride, n * sizeof(float));
+	} else {
+		for (size_t i = 0; i < n; ++i) {
+			xResult[i] = getX(first + i);
+			yResult[i] = getY(first + i);
+		}
+	}
+
+	if (validMask != nullptr) {
+		for (size_t i = 0; i < n; ++i) {
+			if (validMask[first + i] == 0) {
+				xResult[i] = numeric_limits<float>::quiet_NaN();
+			}
+		}
+	}
+}
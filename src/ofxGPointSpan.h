@@ -0,0 +1,130 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ * @brief Point span class
+ *
+ * An ofxGPointSpan describes a set of points stored in caller-owned memory: a pointer to the first x coordinate, a
+ * pointer to the first y coordinate, the distance in bytes between two consecutive points and the number of points.
+ * The coordinates can be in separate float arrays or interleaved inside an array of structures. An optional validity
+ * mask with one byte per point can be used to exclude some of the points (0 means invalid).
+ *
+ * The span doesn't copy the points, so the memory should stay alive and unmoved while the span is in use. The span can
+ * optionally share the ownership of the memory, in which case it's kept alive until the span and all its copies are
+ * destroyed.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGPointSpan {
+public:
+
+	/**
+	 * @brief Default constructor. Creates an empty span
+	 */
+	ofxGPointSpan();
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param _xs pointer to the first point x coordinate
+	 * @param _ys pointer to the first point y coordinate
+	 * @param _count the number of points
+	 * @param _stride the distance in bytes between two consecutive points
+	 * @param _validMask pointer to the validity mask of the first point. It can be null if all the points are valid
+	 */
+	ofxGPointSpan(const float* _xs, const float* _ys, size_t _count, size_t _stride = sizeof(float),
+			const uint8_t* _validMask = nullptr);
+
+	/**
+	 * @brief Makes the span share the ownership of the memory that contains the points
+	 *
+	 * @param newOwner the object that owns the memory
+	 */
+	void setOwner(const shared_ptr<const void>& newOwner);
+
+	/**
+	 * @brief Returns the number of points in the span
+	 *
+	 * @return the number of points in the span
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Returns true if the span has no points
+	 *
+	 * @return true if the span has no points
+	 */
+	bool empty() const;
+
+	/**
+	 * @brief Returns the x coordinate of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return the point x coordinate
+	 */
+	float getX(size_t index) const;
+
+	/**
+	 * @brief Returns the y coordinate of one of the points
+	 *
+	 * @param index the point position
+	 *
+	 * @return the point y coordinate
+	 */
+	float getY(size_t index) const;
+
+	/**
+	 * @brief Returns true if one of the points is valid: it's not excluded by the mask and its coordinates are finite
+	 *
+	 * @param index the point position
+	 *
+	 * @return true if the point is valid
+	 */
+	bool isValid(size_t index) const;
+
+	/**
+	 * @brief Copies the coordinates of a range of points to two contiguous arrays
+	 *
+	 * The x coordinate of the points excluded by the mask is set to NaN, so they become invalid.
+	 *
+	 * @param first the position of the first point to copy
+	 * @param n the number of points to copy
+	 * @param xResult the array where the x coordinates should be copied
+	 * @param yResult the array where the y coordinates should be copied
+	 */
+	void copyTo(size_t first, size_t n, float* xResult, float* yResult) const;
+
+protected:
+
+	/**
+	 * @brief Pointer to the first point x coordinate
+	 */
+	const uint8_t* xs;
+
+	/**
+	 * @brief Pointer to the first point y coordinate
+	 */
+	const uint8_t* ys;
+
+	/**
+	 * @brief The number of points
+	 */
+	size_t count;
+
+	/**
+	 * @brief The distance in bytes between two consecutive points
+	 */
+	size_t stride;
+
+	/**
+	 * @brief Pointer to the validity mask of the first point
+	 */
+	const uint8_t* validMask;
+
+	/**
+	 * @brief The object that owns the memory. It can be null if the memory is owned by the caller
+	 */
+	shared_ptr<const void> owner;
+};
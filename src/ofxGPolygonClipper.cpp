@@ -0,0 +1,69 @@
+#include "ofxGPolygonClipper.h"
+#include "ofxGConstants.h"
+#include "ofMain.h"
+
+ofxGPolygonClipper::ofxGPolygonClipper() {
+}
+
+const vector<glm::vec3>& ofxGPolygonClipper::clip(const vector<glm::vec3>& polygon, const array<float, 2>& dim) {
+	output.assign(polygon.begin(), polygon.end());
+
+	// Clip the polygon with each border. The result of one border is the input of the next one
+	clipBorder(GRAFICA_LEFT_BORDER, 0);
+	clipBorder(GRAFICA_RIGHT_BORDER, dim[0]);
+	clipBorder(GRAFICA_BOTTOM_BORDER, -dim[1]);
+	clipBorder(GRAFICA_TOP_BORDER, 0);
+
+	return output;
+}
+
+void ofxGPolygonClipper::clipBorder(ofxGBoxBorder border, float borderValue) {
+	swap(input, output);
+	output.clear();
+
+	if (input.empty()) {
+		return;
+	}
+
+	const glm::vec3* previous = &input.back();
+	bool previousInside = isInside(*previous, border, borderValue);
+
+	for (const glm::vec3& current : input) {
+		bool currentInside = isInside(current, border, borderValue);
+
+		if (currentInside != previousInside) {
+			output.push_back(getIntersection(*previous, current, border, borderValue));
+		}
+
+		if (currentInside) {
+			output.push_back(current);
+		}
+
+		previous = &current;
+		previousInside = currentInside;
+	}
+}
+
+bool ofxGPolygonClipper::isInside(const glm::vec3& vertex, ofxGBoxBorder border, float borderValue) const {
+	switch (border) {
+	case GRAFICA_LEFT_BORDER:
+		return vertex.x >= borderValue;
+	case GRAFICA_RIGHT_BORDER:
+		return vertex.x <= borderValue;
+	case GRAFICA_BOTTOM_BORDER:
+		return vertex.y >= borderValue;
+	default:
+		return vertex.y <= borderValue;
+	}
+}
+
+glm::vec3 ofxGPolygonClipper::getIntersection(const glm::vec3& start, const glm::vec3& end, ofxGBoxBorder border,
+		float borderValue) const {
+	if (border == GRAFICA_LEFT_BORDER || border == GRAFICA_RIGHT_BORDER) {
+		float t = (borderValue - start.x) / (end.x - start.x);
+		return glm::vec3(borderValue, start.y + t * (end.y - start.y), 0);
+	} else {
+		float t = (borderValue - start.y) / (end.y - start.y);
+		return glm::vec3(start.x + t * (end.x - start.x), borderValue, 0);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ofxGConstants.h"
+#include "ofMain.h"
+
+/**
+ * @brief Polygon clipper class
+ *
+ * An ofxGPolygonClipper clips polygons against the plot box using the Sutherland–Hodgman algorithm. The polygon is
+ * clipped by each box border in turn. The intermediate vertices are kept in internal buffers that are reused between
+ * calls, so clipping many polygons doesn't allocate memory once the buffers are large enough.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGPolygonClipper {
+public:
+
+	/**
+	 * @brief Constructor
+	 */
+	ofxGPolygonClipper();
+
+	/**
+	 * @brief Clips a polygon against the plot box
+	 *
+	 * @param polygon the polygon vertices in the plot reference system
+	 * @param dim the plot box dimensions. The box goes from 0 to dim[0] in x and from -dim[1] to 0 in y
+	 *
+	 * @return the vertices of the clipped polygon. They are only valid until the next call to this method
+	 */
+	const vector<glm::vec3>& clip(const vector<glm::vec3>& polygon, const array<float, 2>& dim);
+
+protected:
+
+	/**
+	 * @brief Clips the polygon in the input buffer with one of the box borders and saves the result in the output
+	 * buffer
+	 *
+	 * @param border the box border
+	 * @param borderValue the border coordinate
+	 */
+	void clipBorder(ofxGBoxBorder border, float borderValue);
+
+	/**
+	 * @brief Checks if a vertex is on the inner side of a box border
+	 *
+	 * @param vertex the vertex to check
+	 * @param border the box border
+	 * @param borderValue the border coordinate
+	 *
+	 * @return true if the vertex is on the inner side of the border
+	 */
+	bool isInside(const glm::vec3& vertex, ofxGBoxBorder border, float borderValue) const;
+
+	/**
+	 * @brief Calculates the intersection of a polygon edge with a box border
+	 *
+	 * @param start the edge start vertex
+	 * @param end the edge end vertex
+	 * @param border the box border
+	 * @param borderValue the border coordinate
+	 *
+	 * @return the intersection. The coordinate perpendicular to the border is exactly the border coordinate
+	 */
+	glm::vec3 getIntersection(const glm::vec3& start, const glm::vec3& end, ofxGBoxBorder border,
+			float borderValue) const;
+
+	/**
+	 * @brief The buffer with the polygon vertices before clipping with a border
+	 */
+	vector<glm::vec3> input;
+
+	/**
+	 * @brief The buffer with the polygon vertices after clipping with a border
+	 */
+	vector<glm::vec3> output;
+};
@@ -0,0 +1,389 @@
+#include "ofxGTable.h"
+#include "ofxGPoint.h"
+#include "ofxGPointSpan.h"
+#include "ofxGLayer.h"
+#include "ofMain.h"
+
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define OFXG_USE_FROM_CHARS
+#endif
+
+ofxGTable::ofxGTable() :
+		numRows(0) {
+}
+
+bool ofxGTable::load(const string& path, char separator, bool hasHeader) {
+	if (!ofFile::doesFileExist(path)) {
+		ofLogError("Couldn't find the file " + path);
+		return false;
+	}
+
+	ofBuffer buffer = ofBufferFromFile(path);
+	parse(buffer.getData(), buffer.size(), separator, hasHeader);
+
+	return true;
+}
+
+void ofxGTable::parse(const char* text, size_t size, char separator, bool hasHeader) {
+	columnNames.clear();
+	columnIsText.clear();
+	columns.clear();
+	textColumns.clear();
+	numRows = 0;
+
+	// Skip the UTF-8 byte order mark
+	const char* end = text + size;
+
+	if (size >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+		text += 3;
+	}
+
+	// Read the column names from the header
+	const char* dataStart = text;
+	vector<pair<const char*, const char*>> cells;
+
+	if (hasHeader && dataStart < end) {
+		const char* lineEnd = find(dataStart, end, '\n');
+		splitLine(dataStart, lineEnd, separator, cells);
+
+		for (const pair<const char*, const char*>& cell : cells) {
+			columnNames.emplace_back(cell.first, cell.second);
+		}
+
+		dataStart = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	// Use the first data row to find the number of columns, if there is no header, and the text columns
+	const char* firstRow = dataStart;
+	const char* firstRowEnd = find(firstRow, end, '\n');
+
+	while (firstRow < end && countRows(firstRow, firstRowEnd) == 0) {
+		firstRow = (firstRowEnd < end) ? firstRowEnd + 1 : end;
+		firstRowEnd = find(firstRow, end, '\n');
+	}
+
+	cells.clear();
+
+	if (firstRow < end) {
+		splitLine(firstRow, firstRowEnd, separator, cells);
+	}
+
+	if (!hasHeader) {
+		for (size_t i = 0; i < cells.size(); ++i) {
+			columnNames.push_back(ofToString(i));
+		}
+	}
+
+	for (size_t i = 0; i < columnNames.size(); ++i) {
+		float value;
+		columnIsText.push_back(i < cells.size() && cells[i].first != cells[i].second
+				&& !parseNumber(cells[i].first, cells[i].second, value));
+	}
+
+	// Divide the data in chunks that start at the beginning of a line. Each thread should have enough data to
+	// compensate the thread creation cost
+	size_t dataSize = end - dataStart;
+	size_t minBytesPerThread = 1 << 20;
+	size_t nThreads = std::min(size_t(std::max(thread::hardware_concurrency(), 1u)),
+			dataSize / minBytesPerThread + 1);
+	vector<const char*> chunkStarts(nThreads + 1, end);
+	chunkStarts[0] = dataStart;
+
+	for (size_t t = 1; t < nThreads; ++t) {
+		const char* lineEnd = find(std::max(dataStart + t * (dataSize / nThreads), chunkStarts[t - 1]), end, '\n');
+		chunkStarts[t] = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	// Count the rows in each chunk to know where their values should be saved
+	vector<size_t> chunkRows(nThreads, 0);
+	vector<thread> threads;
+
+	for (size_t t = 1; t < nThreads; ++t) {
+		threads.emplace_back([&chunkRows, &chunkStarts, t]() {
+			chunkRows[t] = countRows(chunkStarts[t], chunkStarts[t + 1]);
+		});
+	}
+
+	chunkRows[0] = countRows(chunkStarts[0], chunkStarts[1]);
+
+	for (thread& t : threads) {
+		t.join();
+	}
+
+	vector<size_t> chunkFirstRows(nThreads, 0);
+
+	for (size_t t = 1; t < nThreads; ++t) {
+		chunkFirstRows[t] = chunkFirstRows[t - 1] + chunkRows[t - 1];
+	}
+
+	numRows = chunkFirstRows.back() + chunkRows.back();
+	columns.resize(columnNames.size());
+	textColumns.resize(columnNames.size());
+
+	for (size_t i = 0; i < columnNames.size(); ++i) {
+		if (columnIsText[i]) {
+			textColumns[i].resize(numRows);
+		} else {
+			columns[i].assign(numRows, numeric_limits<float>::quiet_NaN());
+		}
+	}
+
+	// Parse the chunks
+	threads.clear();
+
+	for (size_t t = 1; t < nThreads; ++t) {
+		threads.emplace_back(&ofxGTable::parseRows, this, chunkStarts[t], chunkStarts[t + 1], separator,
+				chunkFirstRows[t]);
+	}
+
+	parseRows(chunkStarts[0], chunkStarts[1], separator, chunkFirstRows[0]);
+
+	for (thread& t : threads) {
+		t.join();
+	}
+}
+
+size_t ofxGTable::getNumRows() const {
+	return numRows;
+}
+
+size_t ofxGTable::getNumColumns() const {
+	return columnNames.size();
+}
+
+const string& ofxGTable::getColumnName(size_t column) const {
+	checkColumn(column);
+
+	return columnNames[column];
+}
+
+int ofxGTable::getColumnIndex(const string& name) const {
+	for (size_t i = 0; i < columnNames.size(); ++i) {
+		if (columnNames[i] == name) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool ofxGTable::isTextColumn(size_t column) const {
+	checkColumn(column);
+
+	return columnIsText[column];
+}
+
+const vector<float>& ofxGTable::getColumn(size_t column) const {
+	checkColumn(column);
+
+	if (columnIsText[column]) {
+		throw invalid_argument("The column contains text.");
+	}
+
+	return columns[column];
+}
+
+const vector<string>& ofxGTable::getTextColumn(size_t column) const {
+	checkColumn(column);
+
+	if (!columnIsText[column]) {
+		throw invalid_argument("The column doesn't contain text.");
+	}
+
+	return textColumns[column];
+}
+
+vector<ofxGPoint> ofxGTable::getPoints(size_t xColumn, size_t yColumn, int labelColumn) const {
+	const vector<float>& xs = getColumn(xColumn);
+	const vector<float>& ys = getColumn(yColumn);
+	vector<ofxGPoint> points;
+	points.reserve(numRows);
+
+	if (labelColumn < 0) {
+		for (size_t i = 0; i < numRows; ++i) {
+			points.emplace_back(xs[i], ys[i]);
+		}
+	} else {
+		const vector<string>& labels = getTextColumn(labelColumn);
+
+		for (size_t i = 0; i < numRows; ++i) {
+			points.emplace_back(xs[i], ys[i], labels[i]);
+		}
+	}
+
+	return points;
+}
+
+ofxGPointSpan ofxGTable::getPointsSpan(size_t xColumn, size_t yColumn) const {
+	return ofxGPointSpan(getColumn(xColumn).data(), getColumn(yColumn).data(), numRows);
+}
+
+ofxGLayer ofxGTable::getLayer(const string& id, size_t xColumn, size_t yColumn, int labelColumn,
+		int sizeColumn) const {
+	ofxGLayer layer(id);
+
+	// Copy the columns directly, without creating the intermediate points
+	if (labelColumn < 0) {
+		layer.setPoints(getColumn(xColumn), getColumn(yColumn));
+	} else {
+		layer.setPoints(getColumn(xColumn), getColumn(yColumn), getTextColumn(labelColumn));
+	}
+
+	if (sizeColumn >= 0) {
+		layer.setPointSizes(getColumn(sizeColumn));
+	}
+
+	return layer;
+}
+
+ofxGLayer ofxGTable::getLayer(const string& id, const string& xColumnName, const string& yColumnName,
+		const string& labelColumnName, const string& sizeColumnName) const {
+	int xColumn = getColumnIndex(xColumnName);
+	int yColumn = getColumnIndex(yColumnName);
+	int labelColumn = (labelColumnName == "") ? -1 : getColumnIndex(labelColumnName);
+	int sizeColumn = (sizeColumnName == "") ? -1 : getColumnIndex(sizeColumnName);
+
+	if (xColumn < 0 || yColumn < 0 || (labelColumnName != "" && labelColumn < 0)
+			|| (sizeColumnName != "" && sizeColumn < 0)) {
+		throw invalid_argument("Couldn't find a column with the given name.");
+	}
+
+	return getLayer(id, xColumn, yColumn, labelColumn, sizeColumn);
+}
+
+size_t ofxGTable::countRows(const char* first, const char* last) {
+	size_t nRows = 0;
+
+	while (first < last) {
+		const char* lineEnd = find(first, last, '\n');
+
+		// Lines with only a carriage return are empty too
+		if (lineEnd - first > 1 || (lineEnd - first == 1 && *first != '\r')) {
+			++nRows;
+		}
+
+		first = (lineEnd < last) ? lineEnd + 1 : last;
+	}
+
+	return nRows;
+}
+
+void ofxGTable::splitLine(const char* first, const char* last, char separator,
+		vector<pair<const char*, const char*>>& cells) {
+	cells.clear();
+
+	// Remove the carriage return of Windows line endings
+	if (last > first && *(last - 1) == '\r') {
+		--last;
+	}
+
+	const char* cellStart = first;
+
+	while (true) {
+		const char* cellEnd = find(cellStart, last, separator);
+
+		// Remove the spaces and quotes around the cell
+		const char* valueStart = cellStart;
+		const char* valueEnd = cellEnd;
+
+		while (valueStart < valueEnd && *valueStart == ' ') {
+			++valueStart;
+		}
+
+		while (valueEnd > valueStart && *(valueEnd - 1) == ' ') {
+			--valueEnd;
+		}
+
+		if (valueEnd - valueStart >= 2 && *valueStart == '"' && *(valueEnd - 1) == '"') {
+			++valueStart;
+			--valueEnd;
+		}
+
+		cells.emplace_back(valueStart, valueEnd);
+
+		if (cellEnd == last) {
+			break;
+		}
+
+		cellStart = cellEnd + 1;
+	}
+}
+
+bool ofxGTable::parseNumber(const char* first, const char* last, float& value) {
+	// from_chars doesn't accept a leading plus sign
+	if (first < last && *first == '+') {
+		++first;
+	}
+
+#ifdef OFXG_USE_FROM_CHARS
+	from_chars_result result = from_chars(first, last, value);
+	bool isNumber = result.ec == errc() && result.ptr == last;
+#else
+	// strtof needs a null terminated string. Copy the cell to a local buffer, unless it's too long
+	char buffer[64];
+	string longCell;
+	const char* text = buffer;
+	size_t length = last - first;
+
+	if (length < sizeof(buffer)) {
+		memcpy(buffer, first, length);
+		buffer[length] = '\0';
+	} else {
+		longCell.assign(first, last);
+		text = longCell.c_str();
+	}
+
+	// Skip the cells that strtof would accept but from_chars not: empty, with leading spaces, with a second sign or
+	// out of the float range
+	char* end;
+	errno = 0;
+	value = strtof(text, &end);
+	bool isNumber = length > 0 && !isspace(static_cast<unsigned char>(*first)) && *first != '+'
+			&& end == text + length && errno != ERANGE;
+#endif
+
+	if (!isNumber) {
+		value = numeric_limits<float>::quiet_NaN();
+		return false;
+	}
+
+	return true;
+}
+
+void ofxGTable::parseRows(const char* first, const char* last, char separator, size_t firstRow) {
+	vector<pair<const char*, const char*>> cells;
+	size_t row = firstRow;
+
+	while (first < last) {
+		const char* lineEnd = find(first, last, '\n');
+
+		if (countRows(first, lineEnd) > 0) {
+			splitLine(first, lineEnd, separator, cells);
+			size_t nCells = std::min(cells.size(), columnNames.size());
+
+			for (size_t i = 0; i < nCells; ++i) {
+				if (columnIsText[i]) {
+					textColumns[i][row].assign(cells[i].first, cells[i].second);
+				} else {
+					parseNumber(cells[i].first, cells[i].second, columns[i][row]);
+				}
+			}
+
+			++row;
+		}
+
+		first = (lineEnd < last) ? lineEnd + 1 : last;
+	}
+}
+
+void ofxGTable::checkColumn(size_t column) const {
+	if (column >= columnNames.size()) {
+		throw invalid_argument("The column index should be smaller than the number of columns.");
+	}
+}
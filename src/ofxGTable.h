@@ -0,0 +1,239 @@
+#pragma once
+
+#include "ofxGPoint.h"
+#include "ofxGPointSpan.h"
+#include "ofxGLayer.h"
+#include "ofMain.h"
+
+/**
+ * @brief Table class
+ *
+ * An ofxGTable loads a delimited text file (CSV) into column arrays. The file is divided in chunks that are parsed in
+ * parallel, and the numbers are read directly from the file buffer with std::from_chars, without creating intermediate
+ * strings. Standard libraries without floating point std::from_chars use strtof on a small copy of each cell instead.
+ *
+ * A column is considered a text column if its value in the first data row is not a number. The text columns are
+ * stored as strings and the rest as floats. Empty or invalid numbers are stored as NaN, so the corresponding points
+ * are invalid. Quoted fields are unquoted, but they should not contain separators or line breaks.
+ *
+ * The columns can be used to create ready to plot layers, selecting which columns should be used as the point x and
+ * y coordinates, labels and sizes. The layers are filled directly from the columns. The labels should be stored in a
+ * text column.
+ *
+ * @author Javier Graciá Carpio
+ */
+class ofxGTable {
+public:
+
+	/**
+	 * @brief Constructor
+	 */
+	ofxGTable();
+
+	/**
+	 * @brief Loads a delimited text file, replacing the current columns
+	 *
+	 * @param path the path to the file, relative to the data folder
+	 * @param separator the character that separates the columns
+	 * @param hasHeader true if the first line contains the column names
+	 *
+	 * @return true if the file could be loaded
+	 */
+	bool load(const string& path, char separator = ',', bool hasHeader = true);
+
+	/**
+	 * @brief Parses a delimited text, replacing the current columns
+	 *
+	 * @param text pointer to the first character of the text
+	 * @param size the text size in bytes
+	 * @param separator the character that separates the columns
+	 * @param hasHeader true if the first line contains the column names
+	 */
+	void parse(const char* text, size_t size, char separator = ',', bool hasHeader = true);
+
+	/**
+	 * @brief Returns the number of rows
+	 *
+	 * @return the number of rows
+	 */
+	size_t getNumRows() const;
+
+	/**
+	 * @brief Returns the number of columns
+	 *
+	 * @return the number of columns
+	 */
+	size_t getNumColumns() const;
+
+	/**
+	 * @brief Returns the name of a column. The columns are named by their index if the file has no header
+	 *
+	 * @param column the column index
+	 *
+	 * @return the column name
+	 */
+	const string& getColumnName(size_t column) const;
+
+	/**
+	 * @brief Returns the index of a column
+	 *
+	 * @param name the column name
+	 *
+	 * @return the column index. It will return -1 if there is no column with that name
+	 */
+	int getColumnIndex(const string& name) const;
+
+	/**
+	 * @brief Checks if a column contains text
+	 *
+	 * @param column the column index
+	 *
+	 * @return true if the column contains text
+	 */
+	bool isTextColumn(size_t column) const;
+
+	/**
+	 * @brief Returns the values of a numeric column
+	 *
+	 * @param column the column index
+	 *
+	 * @return the column values
+	 */
+	const vector<float>& getColumn(size_t column) const;
+
+	/**
+	 * @brief Returns the values of a text column
+	 *
+	 * @param column the column index
+	 *
+	 * @return the column values
+	 */
+	const vector<string>& getTextColumn(size_t column) const;
+
+	/**
+	 * @brief Returns the table rows as points
+	 *
+	 * @param xColumn the index of the column with the x coordinates
+	 * @param yColumn the index of the column with the y coordinates
+	 * @param labelColumn the index of the text column with the labels. Use -1 for no labels
+	 *
+	 * @return the table points
+	 */
+	vector<ofxGPoint> getPoints(size_t xColumn, size_t yColumn, int labelColumn = -1) const;
+
+	/**
+	 * @brief Returns a span with the table rows as points. The points are not copied, so the table should stay alive
+	 * while the span is in use
+	 *
+	 * @param xColumn the index of the column with the x coordinates
+	 * @param yColumn the index of the column with the y coordinates
+	 *
+	 * @return the span with the table points
+	 */
+	ofxGPointSpan getPointsSpan(size_t xColumn, size_t yColumn) const;
+
+	/**
+	 * @brief Creates a layer with the table rows as points
+	 *
+	 * @param id the layer id
+	 * @param xColumn the index of the column with the x coordinates
+	 * @param yColumn the index of the column with the y coordinates
+	 * @param labelColumn the index of the text column with the labels. Use -1 for no labels
+	 * @param sizeColumn the index of the column with the point sizes. Use -1 to use the default point size
+	 *
+	 * @return the new layer
+	 */
+	ofxGLayer getLayer(const string& id, size_t xColumn, size_t yColumn, int labelColumn = -1,
+			int sizeColumn = -1) const;
+
+	/**
+	 * @brief Creates a layer with the table rows as points
+	 *
+	 * @param id the layer id
+	 * @param xColumnName the name of the column with the x coordinates
+	 * @param yColumnName the name of the column with the y coordinates
+	 * @param labelColumnName the name of the text column with the labels. Use an empty string for no labels
+	 * @param sizeColumnName the name of the column with the point sizes. Use an empty string to use the default point
+	 * size
+	 *
+	 * @return the new layer
+	 */
+	ofxGLayer getLayer(const string& id, const string& xColumnName, const string& yColumnName,
+			const string& labelColumnName = "", const string& sizeColumnName = "") const;
+
+protected:
+
+	/**
+	 * @brief Counts the non-empty lines in a range of text
+	 *
+	 * @param first pointer to the first character. It should be the start of a line
+	 * @param last pointer after the last character. It should be the end of a line
+	 *
+	 * @return the number of non-empty lines
+	 */
+	static size_t countRows(const char* first, const char* last);
+
+	/**
+	 * @brief Splits a line in its cells, removing the spaces and quotes around them
+	 *
+	 * @param first pointer to the first character of the line
+	 * @param last pointer after the last character of the line
+	 * @param separator the character that separates the cells
+	 * @param cells the vector where the cell limits should be saved. It's cleared first
+	 */
+	static void splitLine(const char* first, const char* last, char separator,
+			vector<pair<const char*, const char*>>& cells);
+
+	/**
+	 * @brief Parses a number
+	 *
+	 * @param first pointer to the first character of the number
+	 * @param last pointer after the last character of the number
+	 * @param value the parsed number. It will be NaN if the text is not a number
+	 *
+	 * @return true if the whole text is a number
+	 */
+	static bool parseNumber(const char* first, const char* last, float& value);
+
+	/**
+	 * @brief Parses the rows in a range of text and saves their values in the columns
+	 *
+	 * @param first pointer to the first character. It should be the start of a line
+	 * @param last pointer after the last character. It should be the end of a line
+	 * @param separator the character that separates the columns
+	 * @param firstRow the index of the first row in the range
+	 */
+	void parseRows(const char* first, const char* last, char separator, size_t firstRow);
+
+	/**
+	 * @brief Checks that a column index is inside the table range
+	 *
+	 * @param column the column index
+	 */
+	void checkColumn(size_t column) const;
+
+	/**
+	 * @brief The column names
+	 */
+	vector<string> columnNames;
+
+	/**
+	 * @brief Defines if the columns contain text
+	 */
+	vector<bool> columnIsText;
+
+	/**
+	 * @brief The numeric column values. They are empty for the text columns
+	 */
+	vector<vector<float>> columns;
+
+	/**
+	 * @brief The text column values. They are empty for the numeric columns
+	 */
+	vector<vector<string>> textColumns;
+
+	/**
+	 * @brief The number of rows
+	 */
+	size_t numRows;
+};
@@ -1,5 +1,6 @@
 #include "ofxGTitle.h"
 #include "ofxGConstants.h"
+#include "ofxGFontRegistry.h"
 #include "ofMain.h"
 
 ofxGTitle::ofxGTitle(const array<float, 2>& _dim, const string& _text) :
@@ -15,26 +16,26 @@ ofxGTitle::ofxGTitle(const array<float, 2>& _dim, const string& _text) :
 	fontColor = ofColor(100);
 	fontSize = 10;
 	fontMakeContours = false;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGTitle::draw() const {
 	ofPushStyle();
 	ofSetColor(fontColor);
-	ofRectangle bounds = font.getStringBoundingBox(text, 0, 0);
+	ofRectangle bounds = font->getStringBoundingBox(text, 0, 0);
 
 	switch (textAlignment) {
 	case GRAFICA_CENTER_ALIGN:
-		font.drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
+		font->drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
 		break;
 	case GRAFICA_LEFT_ALIGN:
-		font.drawString(text, plotPos, -offset - dim[1]);
+		font->drawString(text, plotPos, -offset - dim[1]);
 		break;
 	case GRAFICA_RIGHT_ALIGN:
-		font.drawString(text, plotPos - bounds.width, -offset - dim[1]);
+		font->drawString(text, plotPos - bounds.width, -offset - dim[1]);
 		break;
 	default:
-		font.drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
+		font->drawString(text, plotPos - bounds.width / 2, -offset - dim[1]);
 		break;
 	}
 
@@ -73,7 +74,7 @@ void ofxGTitle::setTextAlignment(ofxGTextAlignment newTextAlignment) {
 
 void ofxGTitle::setFontName(const string& newFontName) {
 	fontName = newFontName;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGTitle::setFontColor(const ofColor& newFontColor) {
@@ -86,7 +87,7 @@ void ofxGTitle::setFontSize(int newFontSize) {
 	}
 
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGTitle::setFontProperties(const string& newFontName, const ofColor& newFontColor, int newFontSize) {
@@ -97,10 +98,10 @@ void ofxGTitle::setFontProperties(const string& newFontName, const ofColor& newF
 	fontName = newFontName;
 	fontColor = newFontColor;
 	fontSize = newFontSize;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
 
 void ofxGTitle::setFontMakeContours(bool newFontMakeContours) {
 	fontMakeContours = newFontMakeContours;
-	font.load(fontName, fontSize, true, true, fontMakeContours);
+	font = ofxGFontRegistry::getFont(fontName, fontSize, fontMakeContours);
 }
@@ -158,7 +158,7 @@ protected:
 	bool fontMakeContours;
 
 	/**
-	 * @brief The trueType font
+	 * @brief The trueType font. It is shared with the other plot components that use the same font properties
 	 */
-	ofTrueTypeFont font;
+	shared_ptr<ofTrueTypeFont> font;
 };
@@ -2,9 +2,21 @@
 
 #include "ofxGConstants.h"
 #include "ofxGPoint.h"
+#include "ofxGFontRegistry.h"
+#include "ofxGLimitsTracker.h"
+#include "ofxGPointSpan.h"
+#include "ofxGPointArray.h"
+#include "ofxGPointGrid.h"
+#include "ofxGLineDecimator.h"
+#include "ofxGLineClipper.h"
+#include "ofxGPolygonClipper.h"
+#include "ofxGDensityMap.h"
 #include "ofxGTitle.h"
 #include "ofxGAxisLabel.h"
 #include "ofxGAxis.h"
 #include "ofxGHistogram.h"
 #include "ofxGLayer.h"
+#include "ofxGHistogramBinner.h"
+#include "ofxGDataSource.h"
+#include "ofxGTable.h"
 #include "ofxGPlot.h"
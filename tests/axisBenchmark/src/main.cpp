@@ -0,0 +1,37 @@
+#include "ofMain.h"
+#include "ofxGrafica.h"
+#include <chrono>
+
+// Moves the axis limits as if the plot was panned and returns the mean time per moveLim call in microseconds
+double timeMoveLim(bool logScale, int nCalls) {
+	array<float, 2> lim = logScale ? array<float, 2> { 1, 1000 } : array<float, 2> { 0, 10 };
+	ofxGAxis axis(GRAFICA_X_AXIS, { 500, 300 }, lim, logScale);
+	float step = logScale ? 1.001 : 0.01;
+	auto start = chrono::steady_clock::now();
+
+	for (int i = 0; i < nCalls; ++i) {
+		if (logScale) {
+			lim = {lim[0] * step, lim[1] * step};
+		} else {
+			lim = {lim[0] + step, lim[1] + step};
+		}
+
+		axis.moveLim(lim);
+	}
+
+	auto end = chrono::steady_clock::now();
+
+	return chrono::duration<double, micro>(end - start).count() / nCalls;
+}
+
+int main() {
+	int nCalls = 20000;
+
+	// Run once to warm up the caches and the allocator
+	timeMoveLim(false, nCalls);
+
+	ofLogNotice("Linear axis: " + ofToString(timeMoveLim(false, nCalls), 3) + " us per moveLim call");
+	ofLogNotice("Logarithmic axis: " + ofToString(timeMoveLim(true, nCalls), 3) + " us per moveLim call");
+
+	return EXIT_SUCCESS;
+}
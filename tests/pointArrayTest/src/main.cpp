@@ -0,0 +1,58 @@
+#include "ofMain.h"
+#include "ofxGrafica.h"
+
+// Layer subclass that gives access to the plot points
+class TestLayer: public ofxGLayer {
+public:
+	TestLayer(const string& _id) :
+			ofxGLayer(_id) {
+	}
+
+	const ofxGPointArray& getPlotPoints() const {
+		return plotPoints;
+	}
+};
+
+// Checks that the transformed view of a masked span agrees with the span mask and with the detached copy
+int checkMaskedSpanView(bool logScale) {
+	vector<float> xs = {1, 2, 3, 4};
+	vector<float> ys = {1, 2, 3, 4};
+	vector<uint8_t> mask = {1, 0, 1, 1};
+	ofxGPointSpan span(xs.data(), ys.data(), xs.size(), sizeof(float), mask.data());
+
+	TestLayer layer("layer");
+	layer.setXLim(0.5, 5);
+	layer.setYLim(0.5, 5);
+	layer.setXLogScale(logScale);
+	layer.setYLogScale(logScale);
+	layer.setPoints(span);
+	int nErrors = 0;
+
+	for (size_t i = 0; i < span.size(); ++i) {
+		const ofxGPointArray& plotPoints = layer.getPlotPoints();
+
+		if (plotPoints.isValid(i) != span.isValid(i) || (plotPoints.isInside(i) && !span.isValid(i))) {
+			ofLogError("Point " + ofToString(i) + " of the view doesn't follow the span mask");
+			++nErrors;
+		}
+	}
+
+	// Modifying a point detaches the view, which should keep the same valid points
+	layer.setPoint(3, 4, 4);
+
+	for (size_t i = 0; i < span.size(); ++i) {
+		if (layer.getPlotPoints().isValid(i) != span.isValid(i)) {
+			ofLogError("Point " + ofToString(i) + " of the detached points doesn't follow the span mask");
+			++nErrors;
+		}
+	}
+
+	return nErrors;
+}
+
+int main() {
+	int nErrors = checkMaskedSpanView(false) + checkMaskedSpanView(true);
+	ofLogNotice(ofToString(nErrors) + " errors");
+
+	return (nErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}